@@ -80,6 +80,12 @@ namespace QArch
         bool avx : 1;
         bool f16c : 1;
         bool rdrand : 1;
+
+        // Structured extended features (EBX from CPUID 7.0)
+        bool bmi1 : 1;
+        bool avx2 : 1;
+        bool bmi2 : 1;
+        bool erms : 1;
     };
 
     class CPU
@@ -101,6 +107,10 @@ namespace QArch
 
         const CPUFeatures &features() const { return m_features; }
 
+        /// True once the OS has enabled AVX register state (CR4.OSXSAVE + XCR0),
+        /// i.e. AVX/AVX2 instructions may actually be executed
+        bool avxStateEnabled() const { return m_avxStateEnabled; }
+
         // Control registers
         QC::u64 readCR0();
         QC::u64 readCR2();
@@ -131,6 +141,7 @@ namespace QArch
         QC::u32 m_model;
         QC::u32 m_stepping;
         CPUFeatures m_features;
+        bool m_avxStateEnabled;
     };
 
 } // namespace QArch
@@ -47,6 +47,23 @@ namespace QArch
             // Initialize FPU state.
             asm volatile("fninit" ::: "memory");
         }
+
+        // Enable AVX (YMM) register state via XSAVE so AVX/AVX2 code paths can run.
+        void enableAvxState()
+        {
+            QC::u64 cr4;
+            asm volatile("mov %%cr4, %0" : "=r"(cr4));
+
+            // CR4.OSXSAVE (bit 18): enable XGETBV/XSETBV
+            cr4 |= (1ULL << 18);
+            asm volatile("mov %0, %%cr4" : : "r"(cr4) : "memory");
+
+            // XCR0: x87 (bit 0) | SSE (bit 1) | AVX (bit 2)
+            QC::u32 lo, hi;
+            asm volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+            lo |= 0x7u;
+            asm volatile("xsetbv" : : "a"(lo), "d"(hi), "c"(0) : "memory");
+        }
     }
 
     CPU &CPU::instance()
@@ -55,7 +72,7 @@ namespace QArch
         return instance;
     }
 
-    CPU::CPU() : m_family(0), m_model(0), m_stepping(0)
+    CPU::CPU() : m_family(0), m_model(0), m_stepping(0), m_avxStateEnabled(false)
     {
         QC::String::memset(m_vendorString, 0, sizeof(m_vendorString));
         QC::String::memset(m_brandString, 0, sizeof(m_brandString));
@@ -83,6 +100,14 @@ namespace QArch
             QC_LOG_WARN("QArchCPU", "CPU lacks SSE2; floating-point math may fault");
         }
 
+        // AVX needs XSAVE support as well as the feature bit.
+        if (m_features.sse2 && m_features.xsave && m_features.avx)
+        {
+            enableAvxState();
+            m_avxStateEnabled = true;
+            QC_LOG_INFO("QArchCPU", "AVX state enabled (AVX2: %s)", m_features.avx2 ? "yes" : "no");
+        }
+
         QC_LOG_INFO("QArchCPU", "CPU: %s", m_brandString[0] ? m_brandString : m_vendorString);
         QC_LOG_INFO("QArchCPU", "Family: %u, Model: %u, Stepping: %u",
                     m_family, m_model, m_stepping);
@@ -161,7 +186,19 @@ namespace QArch
         m_features.sse4_1 = info.ecx & (1 << 19);
         m_features.sse4_2 = info.ecx & (1 << 20);
         m_features.aes = info.ecx & (1 << 25);
+        m_features.xsave = info.ecx & (1 << 26);
+        m_features.osxsave = info.ecx & (1 << 27);
         m_features.avx = info.ecx & (1 << 28);
+
+        // Structured extended features
+        if (cpuid(0).eax >= 7)
+        {
+            CPUIDResult ext = cpuid(7, 0);
+            m_features.bmi1 = ext.ebx & (1 << 3);
+            m_features.avx2 = ext.ebx & (1 << 5);
+            m_features.bmi2 = ext.ebx & (1 << 8);
+            m_features.erms = ext.ebx & (1 << 9);
+        }
     }
 
     QC::u64 CPU::readCR0()
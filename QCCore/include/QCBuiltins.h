@@ -114,6 +114,14 @@ namespace QC
         asm volatile("wbinvd" ::: "memory");
     }
 
+    // Time-stamp counter (monotonic per CPU; safe to read from IRQ context)
+    inline u64 rdtsc()
+    {
+        u32 lo, hi;
+        asm volatile("rdtsc" : "=a"(lo), "=d"(hi));
+        return (static_cast<u64>(hi) << 32) | lo;
+    }
+
     // MSR access
     inline u64 read_msr(u32 msr)
     {
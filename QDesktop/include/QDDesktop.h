@@ -184,10 +184,13 @@ namespace QD
         void updateSidebarButtonRoles();
         void resetBackgroundConfig();
         void parseBackground(const QC::JSON::Value *backgroundValue);
-        struct ImageAsset;
-        ImageAsset *findImageAsset(const char *path) const;
-        ImageAsset *loadImageAsset(const char *path);
+        /// Render gradient + image into m_backgroundLayer if its inputs changed
+        bool ensureBackgroundLayer(QW::Color top, QW::Color bottom);
+        void invalidateBackgroundLayer() { m_backgroundLayerValid = false; }
+        /// Image from the shared QG::ImageCache, pinned until releaseImageAssets()
+        const QG::ImageSurface *loadImageAsset(const char *path);
         void releaseImageAssets();
+        bool fileSize(const char *path, QC::u64 &outSize) const;
         bool readFileBytes(const char *path, QC::Vector<QC::u8> &outBuffer) const;
 
         void openTerminal();
@@ -371,12 +374,6 @@ namespace QD
         SetupWizard *m_setupWizard;
         LoginDialog *m_loginDialog;
 
-        struct ImageAsset
-        {
-            char path[128];
-            QG::ImageSurface surface;
-        };
-
         enum class BackgroundMode : QC::u8
         {
             Gradient,
@@ -390,13 +387,22 @@ namespace QD
             QW::Color bottomColor;
             bool topOverride = false;
             bool bottomOverride = false;
-            ImageAsset *image = nullptr;
+            const QG::ImageSurface *image = nullptr;
             QG::ImageScaleMode scaleMode = QG::ImageScaleMode::Stretch;
         };
 
         BackgroundConfig m_backgroundConfig;
-        QC::Vector<ImageAsset *> m_imageAssets;
-        QC::Vector<QC::u32> m_backgroundScratch;
+        QC::Vector<const QG::ImageSurface *> m_imageAssets; // Pins held in QG::ImageCache
+        QG::ScaledImage m_backgroundScaled;
+
+        // Screen-sized background, rebuilt only when the colours, resolution
+        // or image change; repaints copy their damaged part from it.
+        QC::Vector<QC::u32> m_backgroundLayer;
+        QC::u32 m_backgroundLayerWidth;
+        QC::u32 m_backgroundLayerHeight;
+        QW::Color m_backgroundLayerTop;
+        QW::Color m_backgroundLayerBottom;
+        bool m_backgroundLayerValid;
     };
 
 } // namespace QD
@@ -18,24 +18,6 @@
 
 namespace
 {
-    static void destroyOwnedString(void *p)
-    {
-        char *s = static_cast<char *>(p);
-        operator delete[](s);
-    }
-
-    static char *dupString(const char *s)
-    {
-        if (!s)
-            s = "";
-        const QC::usize len = QC::String::strlen(s);
-        char *out = static_cast<char *>(operator new[](len + 1));
-        for (QC::usize i = 0; i < len; ++i)
-            out[i] = s[i];
-        out[len] = '\0';
-        return out;
-    }
-
     static bool publishWindowLine(QC::u32 toWindowId, QC::u32 msgId, QC::u64 correlationId, const char *text)
     {
         QK::Msg::Envelope *env = QK::Msg::makeEnvelope(QK::Msg::Topic::WinMsg, correlationId);
@@ -44,13 +26,18 @@ namespace
         env->param1 = msgId;
         env->param2 = 0;
 
+        // Output lines are delivered directly as borrowed views: the terminal
+        // copies what it keeps, so no per-line heap copy or queue round-trip.
+        bool ok;
         if (text)
         {
-            env->payload = dupString(text);
-            env->destroyPayload = &destroyOwnedString;
+            ok = QK::Msg::Bus::instance().publishBorrowed(env, text, QC::String::strlen(text) + 1);
+        }
+        else
+        {
+            ok = QK::Msg::Bus::instance().publish(env, QK::Msg::Delivery::Direct);
         }
 
-        const bool ok = QK::Msg::Bus::instance().publish(env);
         QK::Msg::release(env);
         return ok;
     }
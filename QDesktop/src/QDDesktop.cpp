@@ -19,6 +19,8 @@
 #include "QKShutdownController.h"
 #include "QGPainter.h"
 #include "QG/Image.h"
+#include "QG/ImageCache.h"
+#include "QG/PainterSurface.h"
 #include "QWControls/Leaf/ImageView.h"
 #include "QWControls/Leaf/ScrollBar.h"
 
@@ -372,7 +374,10 @@ namespace QD
           m_terminal(nullptr),
           m_shutdownDialog(nullptr),
           m_setupWizard(nullptr),
-          m_loginDialog(nullptr)
+          m_loginDialog(nullptr),
+          m_backgroundLayerWidth(0),
+          m_backgroundLayerHeight(0),
+          m_backgroundLayerValid(false)
     {
         for (QC::u8 i = 0; i < static_cast<QC::u8>(SidebarItem::Count); ++i)
         {
@@ -722,27 +727,34 @@ namespace QD
         m_backgroundConfig.bottomColor = QW::Color();
         m_backgroundConfig.topOverride = false;
         m_backgroundConfig.bottomOverride = false;
+        invalidateBackgroundLayer();
     }
 
     void Desktop::releaseImageAssets()
     {
+        // Unpinned images stay decoded in the cache, so the next theme gets
+        // any wallpaper or icon it shares with this one for free.
+        auto &cache = QG::ImageCache::instance();
         for (QC::usize i = 0; i < m_imageAssets.size(); ++i)
         {
-            delete m_imageAssets[i];
+            cache.release(m_imageAssets[i]);
         }
         m_imageAssets.clear();
+        m_backgroundConfig.image = nullptr;
+        invalidateBackgroundLayer();
     }
 
-    Desktop::ImageAsset *Desktop::findImageAsset(const char *path) const
+    bool Desktop::fileSize(const char *path, QC::u64 &outSize) const
     {
+        outSize = 0;
         if (!path || !*path)
-            return nullptr;
-        for (QC::usize i = 0; i < m_imageAssets.size(); ++i)
-        {
-            if (QC::String::strcmp(m_imageAssets[i]->path, path) == 0)
-                return m_imageAssets[i];
-        }
-        return nullptr;
+            return false;
+        QFS::File *file = QFS::VFS::instance().open(path, QFS::OpenMode::Read);
+        if (!file)
+            return false;
+        outSize = file->size();
+        QFS::VFS::instance().close(file);
+        return true;
     }
 
     bool Desktop::readFileBytes(const char *path, QC::Vector<QC::u8> &outBuffer) const
@@ -776,32 +788,35 @@ namespace QD
         return true;
     }
 
-    Desktop::ImageAsset *Desktop::loadImageAsset(const char *path)
+    const QG::ImageSurface *Desktop::loadImageAsset(const char *path)
     {
-        if (ImageAsset *cached = findImageAsset(path))
-            return cached;
-
-        QC::Vector<QC::u8> buffer;
-        if (!readFileBytes(path, buffer))
-            return nullptr;
-
-        auto *asset = new ImageAsset();
-        asset->path[0] = '\0';
-        if (path)
+        // The file system keeps no modification times, so the file size
+        // stands in as the stamp that tells a replaced image apart.
+        QC::u64 size = 0;
+        if (!fileSize(path, size))
         {
-            QC::String::strncpy(asset->path, path, sizeof(asset->path) - 1);
-            asset->path[sizeof(asset->path) - 1] = '\0';
+            QC_LOG_WARN(LOG_MODULE, "Image file %s not found", path ? path : "<null>");
+            return nullptr;
         }
 
-        if (!QG::decodePNG(buffer, asset->surface))
+        auto &cache = QG::ImageCache::instance();
+        const QG::ImageSurface *surface = cache.acquire(path, size);
+        if (!surface)
         {
-            delete asset;
-            QC_LOG_WARN(LOG_MODULE, "Failed to decode PNG %s", path ? path : "<null>");
-            return nullptr;
+            QC::Vector<QC::u8> buffer;
+            if (!readFileBytes(path, buffer))
+                return nullptr;
+
+            surface = cache.insert(path, size, buffer.data(), buffer.size());
+            if (!surface)
+            {
+                QC_LOG_WARN(LOG_MODULE, "Failed to decode PNG %s", path);
+                return nullptr;
+            }
         }
 
-        m_imageAssets.push_back(asset);
-        return asset;
+        m_imageAssets.push_back(surface);
+        return surface;
     }
 
     float Desktop::clamp01(float value)
@@ -1312,10 +1327,10 @@ namespace QD
         if (type && equalsIgnoreCase(type, "image"))
         {
             const char *path = stringOrNull(backgroundValue->find("path"));
-            if (ImageAsset *asset = loadImageAsset(path))
+            if (const QG::ImageSurface *image = loadImageAsset(path))
             {
                 m_backgroundConfig.mode = BackgroundMode::Image;
-                m_backgroundConfig.image = asset;
+                m_backgroundConfig.image = image;
 
                 const char *modeText = stringOrNull(backgroundValue->find("mode"));
                 if (modeText)
@@ -1855,9 +1870,9 @@ namespace QD
                 }
 
                 const char *path = stringOrNull(controlValue->find("path"));
-                if (ImageAsset *asset = loadImageAsset(path))
+                if (const QG::ImageSurface *image = loadImageAsset(path))
                 {
-                    imageView->setImage(&asset->surface);
+                    imageView->setImage(image);
                 }
                 else if (path)
                 {
@@ -2430,11 +2445,43 @@ namespace QD
         QW::Color top = m_backgroundConfig.topOverride ? m_backgroundConfig.topColor : style.palette.desktopBackgroundTop;
         QW::Color bottom = m_backgroundConfig.bottomOverride ? m_backgroundConfig.bottomColor : style.palette.desktopBackgroundBottom;
 
-        QW::Rect bounds = {0, 0, m_screenWidth, m_screenHeight};
         QG::IPainter *painter = m_desktopWindow->painter();
-        if (!painter)
+        if (!painter || !ensureBackgroundLayer(top, bottom))
             return;
 
+        // The painter clip is the window's damaged area, so only that part of
+        // the layer is copied.
+        painter->blit(0, 0,
+                      m_backgroundLayer.data(),
+                      m_backgroundLayerWidth,
+                      m_backgroundLayerHeight,
+                      m_backgroundLayerWidth);
+    }
+
+    bool Desktop::ensureBackgroundLayer(QW::Color top, QW::Color bottom)
+    {
+        if (m_screenWidth == 0 || m_screenHeight == 0)
+            return false;
+
+        if (m_backgroundLayerValid &&
+            m_backgroundLayerWidth == m_screenWidth &&
+            m_backgroundLayerHeight == m_screenHeight &&
+            m_backgroundLayerTop == top &&
+            m_backgroundLayerBottom == bottom)
+        {
+            return true;
+        }
+
+        m_backgroundLayer.resize(static_cast<QC::usize>(m_screenWidth) * m_screenHeight);
+        m_backgroundLayerWidth = m_screenWidth;
+        m_backgroundLayerHeight = m_screenHeight;
+        m_backgroundLayerTop = top;
+        m_backgroundLayerBottom = bottom;
+
+        QG::PainterSurface layer(m_backgroundLayer.data(), m_screenWidth, m_screenHeight, m_screenWidth);
+        QG::IPainter *painter = &layer;
+        QW::Rect bounds = {0, 0, m_screenWidth, m_screenHeight};
+
         if (top == bottom)
         {
             painter->fillRect(bounds, top);
@@ -2444,14 +2491,19 @@ namespace QD
             painter->fillGradientV(bounds, top, bottom);
         }
 
-        if (m_backgroundConfig.mode == BackgroundMode::Image && m_backgroundConfig.image && m_backgroundConfig.image->surface.isValid())
+        if (m_backgroundConfig.mode == BackgroundMode::Image && m_backgroundConfig.image && m_backgroundConfig.image->isValid())
         {
             QG::blitImage(painter,
-                          m_backgroundConfig.image->surface,
+                          *m_backgroundConfig.image,
                           bounds,
                           m_backgroundConfig.scaleMode,
-                          m_backgroundScratch);
+                          m_backgroundScaled);
+            // The background layer keeps the result; no need for a second copy.
+            m_backgroundScaled.reset();
         }
+
+        m_backgroundLayerValid = true;
+        return true;
     }
 
     // ==================== Callbacks ====================
@@ -282,6 +282,7 @@ namespace QD
         QC::Rect outBounds = {8, 8, static_cast<QC::u32>(w - 16), static_cast<QC::u32>(h - 16 - 28)};
         m_output = new QW::Controls::Label(m_window, "QAIOS+ Terminal\nType 'help'\n", outBounds);
         m_output->setWordWrap(true);
+        m_output->setFollowTail(true);
         m_output->setTransparent(false);
         m_output->setBackgroundColor(QW::Color(20, 20, 20, 255));
         m_output->setTextColor(QW::Color(230, 230, 230, 255));
@@ -387,7 +388,8 @@ namespace QD
         const QC::usize need = addLen + 1; // +\n
 
         // If overflow, drop oldest by resetting (minimal behavior)
-        if (m_outputLen + need + 1 >= OUTPUT_CAP)
+        const bool reset = m_outputLen + need + 1 >= OUTPUT_CAP;
+        if (reset)
         {
             m_outputLen = 0;
             m_outputBuf[0] = '\0';
@@ -402,7 +404,11 @@ namespace QD
 
         if (m_output)
         {
-            m_output->setText(m_outputBuf);
+            // Appending lets the label blit the old lines up instead of repainting them.
+            if (reset)
+                m_output->setText(m_outputBuf);
+            else
+                m_output->appendLine(line);
         }
     }
 
@@ -57,6 +57,13 @@ namespace QDrv
         QC::u16 height() const { return m_height; }
         QC::u16 bpp() const { return m_bpp; }
 
+        // Virtual screen / display start (used for page flipping)
+        /// Set the virtual line width; the adapter derives the virtual height from VRAM
+        void setVirtualWidth(QC::u16 width);
+        QC::u16 virtualHeight();
+        /// Scan out starting at (x, y) of the virtual screen
+        void setDisplayOffset(QC::u16 x, QC::u16 y);
+
         // Hardware cursor (if supported)
         bool hasHardwareCursor() const { return m_hasHwCursor; }
         void setCursorPosition(QC::u16 x, QC::u16 y);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "QCTypes.h"
+#include "QCGeometry.h"
 
 namespace QDrv
 {
@@ -39,6 +40,19 @@ namespace QDrv
         void updateRect(QC::u32 x, QC::u32 y, QC::u32 w, QC::u32 h);
         void rectCopy(QC::u32 srcX, QC::u32 srcY, QC::u32 dstX, QC::u32 dstY, QC::u32 w, QC::u32 h);
 
+        /// Queue one UPDATE per rect (already clipped to the screen) and kick the
+        /// FIFO once, without waiting for the host. Returns false if the FIFO is full.
+        bool updateRects(const QC::Rect *rects, QC::usize count);
+
+        // FIFO fences. Without SVGA_FIFO_CAP_FENCE a fence counts as passed once
+        // the host has drained the FIFO.
+        bool hasFences() const { return m_fencesAvailable; }
+        /// Queue a fence behind everything submitted so far (0 if the FIFO is unavailable)
+        QC::u32 insertFence();
+        bool hasFencePassed(QC::u32 fence);
+        /// Block until the fence has passed (bounded; gives up on a stuck host)
+        void syncToFence(QC::u32 fence);
+
     private:
         VmwareSVGA();
         VmwareSVGA(const VmwareSVGA &) = delete;
@@ -47,6 +61,9 @@ namespace QDrv
         QC::u32 readReg(QC::u32 reg) const;
         void writeReg(QC::u32 reg, QC::u32 value) const;
 
+        /// Append dwords at NEXT_CMD, wrapping at MAX, and publish them at once
+        bool writeFifo(const QC::u32 *dwords, QC::u32 count);
+
         bool m_initialized;
         bool m_available;
         bool m_hwCursor;
@@ -59,6 +76,11 @@ namespace QDrv
         volatile QC::u32 *m_fifo;
         QC::u32 m_fifoSizeBytes;
 
+        QC::u32 m_capabilities = 0;
+        bool m_fencesAvailable = false;
+        QC::u32 m_nextFence = 0;
+        QC::u32 m_lastPassedFence = 0;
+
         bool m_cursorDefined = false;
     };
 }
@@ -95,6 +95,31 @@ namespace QDrv
         m_bpp = bpp;
     }
 
+    void BGA::setVirtualWidth(QC::u16 width)
+    {
+        if (!m_available)
+            return;
+
+        writeRegister(BGA_INDEX_VIRT_WIDTH, width);
+    }
+
+    QC::u16 BGA::virtualHeight()
+    {
+        if (!m_available)
+            return 0;
+
+        return readRegister(BGA_INDEX_VIRT_HEIGHT);
+    }
+
+    void BGA::setDisplayOffset(QC::u16 x, QC::u16 y)
+    {
+        if (!m_available)
+            return;
+
+        writeRegister(BGA_INDEX_X_OFFSET, x);
+        writeRegister(BGA_INDEX_Y_OFFSET, y);
+    }
+
     void BGA::setCursorPosition(QC::u16 x, QC::u16 y)
     {
         m_cursorX = x;
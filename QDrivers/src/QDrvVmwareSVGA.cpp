@@ -52,10 +52,18 @@ namespace QDrv
         constexpr QC::u32 SVGA_FIFO_MAX = 1;
         constexpr QC::u32 SVGA_FIFO_NEXT_CMD = 2;
         constexpr QC::u32 SVGA_FIFO_STOP = 3;
+        // Extended FIFO registers (valid when SVGA_CAP_EXTENDED_FIFO is set and MIN leaves room)
+        constexpr QC::u32 SVGA_FIFO_CAPABILITIES = 4;
+        constexpr QC::u32 SVGA_FIFO_FENCE = 6;
+
+        // Capability bits
+        constexpr QC::u32 SVGA_CAP_EXTENDED_FIFO = 0x00008000;
+        constexpr QC::u32 SVGA_FIFO_CAP_FENCE = 1u << 0;
 
         // FIFO commands (legacy 2D)
         constexpr QC::u32 SVGA_CMD_UPDATE = 1;
         constexpr QC::u32 SVGA_CMD_RECT_COPY = 3;
+        constexpr QC::u32 SVGA_CMD_FENCE = 30;
 
         // Cursor FIFO commands
         constexpr QC::u32 SVGA_CMD_DEFINE_CURSOR = 19;
@@ -219,6 +227,7 @@ namespace QDrv
         writeReg(SVGA_REG_ENABLE, 1);
 
         const QC::u32 caps = readReg(SVGA_REG_CAPABILITIES);
+        m_capabilities = caps;
         const QC::u32 modeW = readReg(SVGA_REG_WIDTH);
         const QC::u32 modeH = readReg(SVGA_REG_HEIGHT);
         const QC::u32 bpp = readReg(SVGA_REG_BITS_PER_PIXEL);
@@ -359,8 +368,14 @@ namespace QDrv
         // Tell device FIFO config is complete.
         writeReg(SVGA_REG_CONFIG_DONE, 1);
 
+        // Fences need the extended FIFO register block below MIN.
+        m_fencesAvailable = (m_capabilities & SVGA_CAP_EXTENDED_FIFO) &&
+                            min > SVGA_FIFO_FENCE * sizeof(QC::u32) &&
+                            (m_fifo[SVGA_FIFO_CAPABILITIES] & SVGA_FIFO_CAP_FENCE);
+
         m_2dAvailable = true;
-        QC_LOG_INFO("QDrvSVGA", "SVGA2D FIFO enabled (phys=0x%08X size=0x%08X min=0x%08X max=0x%08X)", fifoStart, fifoSize, min, max);
+        QC_LOG_INFO("QDrvSVGA", "SVGA2D FIFO enabled (phys=0x%08X size=0x%08X min=0x%08X max=0x%08X fences=%u)",
+                    fifoStart, fifoSize, min, max, m_fencesAvailable ? 1u : 0u);
         return true;
     }
 
@@ -506,6 +521,148 @@ namespace QDrv
         }
     }
 
+    bool VmwareSVGA::writeFifo(const QC::u32 *dwords, QC::u32 count)
+    {
+        if (!m_2dAvailable || !m_fifo || count == 0)
+            return false;
+
+        const QC::u32 min = m_fifo[SVGA_FIFO_MIN];
+        const QC::u32 max = m_fifo[SVGA_FIFO_MAX];
+        QC::u32 next = m_fifo[SVGA_FIFO_NEXT_CMD];
+        const QC::u32 stop = m_fifo[SVGA_FIFO_STOP];
+        if (min >= max || next < min || next >= max || stop < min || stop >= max)
+            return false;
+
+        // The host reads [STOP..NEXT_CMD) and wraps at MAX; one dword stays
+        // free so that NEXT_CMD == STOP always means empty.
+        const QC::u32 ring = max - min;
+        const QC::u32 used = (next >= stop) ? (next - stop) : (ring - (stop - next));
+        const QC::u32 bytes = count * sizeof(QC::u32);
+        if (used + bytes + sizeof(QC::u32) > ring)
+            return false;
+
+        volatile QC::u8 *base = reinterpret_cast<volatile QC::u8 *>(m_fifo);
+        for (QC::u32 i = 0; i < count; ++i)
+        {
+            *reinterpret_cast<volatile QC::u32 *>(base + next) = dwords[i];
+            next += sizeof(QC::u32);
+            if (next >= max)
+                next = min;
+        }
+
+        QC::write_barrier();
+        m_fifo[SVGA_FIFO_NEXT_CMD] = next;
+        QC::write_barrier();
+        return true;
+    }
+
+    bool VmwareSVGA::updateRects(const QC::Rect *rects, QC::usize count)
+    {
+        if (!m_2dAvailable || !m_fifo || !rects)
+            return false;
+
+        // Commands go out in chunks so a long list never needs a big stack buffer.
+        constexpr QC::usize ChunkRects = 16;
+        QC::u32 cmds[ChunkRects * 5];
+
+        QC::usize i = 0;
+        while (i < count)
+        {
+            QC::u32 dwords = 0;
+            for (QC::usize n = 0; n < ChunkRects && i < count; ++i)
+            {
+                const QC::Rect &r = rects[i];
+                if (r.isEmpty())
+                    continue;
+
+                cmds[dwords++] = SVGA_CMD_UPDATE;
+                cmds[dwords++] = static_cast<QC::u32>(r.x);
+                cmds[dwords++] = static_cast<QC::u32>(r.y);
+                cmds[dwords++] = r.width;
+                cmds[dwords++] = r.height;
+                ++n;
+            }
+
+            if (dwords && !writeFifo(cmds, dwords))
+            {
+                QC_LOG_WARN("QDrvSVGA", "SVGA2D FIFO full; dropped %lu UPDATEs",
+                            static_cast<unsigned long>(count - i + dwords / 5));
+                writeReg(SVGA_REG_SYNC, 1);
+                return false;
+            }
+        }
+
+        // Kick only; the host works through the FIFO while we compose the next frame.
+        writeReg(SVGA_REG_SYNC, 1);
+        return true;
+    }
+
+    QC::u32 VmwareSVGA::insertFence()
+    {
+        if (!m_2dAvailable || !m_fifo)
+            return 0;
+
+        ++m_nextFence;
+        if (m_nextFence == 0)
+            m_nextFence = 1;
+
+        if (m_fencesAvailable)
+        {
+            const QC::u32 cmd[2] = {SVGA_CMD_FENCE, m_nextFence};
+            if (!writeFifo(cmd, 2))
+            {
+                // No room for the fence: fall back to a full drain.
+                syncToFence(m_nextFence - 1);
+                if (!writeFifo(cmd, 2))
+                    return 0;
+            }
+            writeReg(SVGA_REG_SYNC, 1);
+        }
+
+        return m_nextFence;
+    }
+
+    bool VmwareSVGA::hasFencePassed(QC::u32 fence)
+    {
+        if (fence == 0 || !m_fifo)
+            return true;
+
+        if (static_cast<QC::i32>(m_lastPassedFence - fence) >= 0)
+            return true;
+
+        if (m_fencesAvailable)
+        {
+            m_lastPassedFence = m_fifo[SVGA_FIFO_FENCE];
+        }
+        else if (m_fifo[SVGA_FIFO_STOP] == m_fifo[SVGA_FIFO_NEXT_CMD])
+        {
+            // Drained FIFO: everything queued so far has been consumed.
+            m_lastPassedFence = m_nextFence;
+        }
+
+        return static_cast<QC::i32>(m_lastPassedFence - fence) >= 0;
+    }
+
+    void VmwareSVGA::syncToFence(QC::u32 fence)
+    {
+        if (hasFencePassed(fence))
+            return;
+
+        writeReg(SVGA_REG_SYNC, 1);
+        for (QC::u32 i = 0; i < 100'000; ++i)
+        {
+            if (hasFencePassed(fence))
+                return;
+
+            // Reading BUSY lets the host make progress on the FIFO.
+            if (readReg(SVGA_REG_BUSY) == 0 && hasFencePassed(fence))
+                return;
+        }
+
+        QC_LOG_WARN("QDrvSVGA", "SVGA fence %u did not pass (last=%u); giving up", fence, m_lastPassedFence);
+        m_lastPassedFence = fence;
+    }
+
     void VmwareSVGA::setCursorImage(const QC::u32 *pixels, QC::u16 width, QC::u16 height,
                                     QC::u16 hotspotX, QC::u16 hotspotY)
     {
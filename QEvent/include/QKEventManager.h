@@ -4,6 +4,7 @@
 // Namespace: QK::Event
 
 #include "QCTypes.h"
+#include "QCVector.h"
 #include "QKEventTypes.h"
 #include "QKEventQueue.h"
 #include "QKEventListener.h"
@@ -18,8 +19,17 @@ namespace QK
         class EventManager
         {
         public:
-            /// Maximum number of registered listeners
-            static constexpr QC::usize MaxListeners = 64;
+            /// Initial listener/receiver slot capacity (grows on demand)
+            static constexpr QC::usize InitialListenerCapacity = 64;
+
+            /// Number of hash buckets in the per-Type dispatch index
+            static constexpr QC::usize TypeIndexBuckets = 64;
+
+            /// Number of single-bit categories in the per-Category dispatch index
+            static constexpr QC::usize CategoryIndexBits = 8;
+
+            /// Maximum number of per-type coalescing rules
+            static constexpr QC::usize MaxCoalesceRules = 32;
 
             /// Get the singleton instance
             static EventManager &instance();
@@ -39,7 +49,7 @@ namespace QK
 
             // ==================== Event Posting ====================
 
-            /// Post an event to the queue
+            /// Post an event to the queue (lock-free; safe from IRQ context)
             /// @param event The event to post
             /// @return true if the event was queued
             bool postEvent(const Event &event);
@@ -90,6 +100,20 @@ namespace QK
             /// @return Number of events processed
             QC::usize processEventsUntil(QC::u64 timeoutMs);
 
+            /// Process events until the queue is empty or a TSC deadline passes.
+            /// The immediate queue is always drained and at least one main-queue
+            /// event is dispatched; leftovers stay queued (highest priority first).
+            /// @param deadlineTsc Absolute TSC value to stop at
+            /// @return Number of events processed
+            QC::usize processEventsUntilDeadline(QC::u64 deadlineTsc);
+
+            /// Set the timestamp (TSC) frequency used to convert ms budgets
+            /// @param ticksPerSecond Calibrated TSC frequency (0 = unknown)
+            void setTimestampFrequency(QC::u64 ticksPerSecond);
+
+            /// Get the timestamp (TSC) frequency (0 if not calibrated)
+            QC::u64 timestampFrequency() const { return m_timestampFrequency; }
+
             /// Check if there are pending events
             bool hasPendingEvents() const;
 
@@ -102,6 +126,17 @@ namespace QK
             /// Clear events of a specific type
             void clearEventsOfType(Type type);
 
+            // ==================== Coalescing ====================
+
+            /// Set how queued events of a type merge (None removes the rule)
+            /// Defaults: MouseMove merges, MouseScroll accumulates,
+            /// WindowMove/WindowResize/WindowPaint fold by window id.
+            /// @return false if the rule table is full
+            bool setCoalescePolicy(Type type, CoalescePolicy policy);
+
+            /// Get the coalescing policy for a type
+            CoalescePolicy coalescePolicy(Type type) const;
+
             // ==================== Listener Management ====================
 
             /// Register an event listener
@@ -141,6 +176,12 @@ namespace QK
             /// Get total events dropped (queue full)
             QC::u64 totalEventsDropped() const { return m_totalDropped; }
 
+            /// Get total events merged into an already-queued entry
+            QC::u64 totalEventsCoalesced() const { return m_totalCoalesced; }
+
+            /// Get events of a type merged into an already-queued entry
+            QC::u64 eventsCoalesced(Type type) const;
+
             /// Reset statistics
             void resetStats();
 
@@ -151,6 +192,23 @@ namespace QK
             /// Dispatch a single event to all matching listeners
             void dispatchEvent(const Event &event);
 
+            /// Shared processing loop
+            /// @param maxEvents Maximum events to process (0 = all)
+            /// @param deadlineTsc Absolute TSC deadline (0 = none)
+            QC::usize processQueued(QC::usize maxEvents, QC::u64 deadlineTsc);
+
+            /// Move published ingress events into the dispatch queues
+            /// @return Number of events moved
+            QC::usize drainIngress();
+
+            /// Move published Immediate events into m_immediateQueue while it has room
+            /// @return Number of events moved
+            QC::usize drainImmediateIngress();
+
+            /// Dispatch every Immediate event published so far
+            /// @return Number of events dispatched
+            QC::usize processImmediateEvents();
+
             /// Get the current timestamp
             QC::u64 getTimestamp() const;
 
@@ -161,22 +219,65 @@ namespace QK
             EventListener *findListener(ListenerId id);
             const EventListener *findListener(ListenerId id) const;
 
+            /// Invoke one listener slot if its filters match
+            /// @return true if the event was consumed
+            bool dispatchToListener(QC::u32 slot, const Event &event);
+
+            /// Mark dispatch indexes stale; rebuilt now, or after the outermost dispatch
+            void invalidateIndex();
+
+            /// Rebuild the per-Type / per-Category listener indexes and receiver order
+            void rebuildIndex();
+
+            /// Bucket for a Type in m_typeIndex
+            static QC::usize typeBucket(Type type);
+
+            /// Install the default coalescing rules
+            void resetCoalesceRules();
+
+            struct CoalesceRule
+            {
+                Type type;
+                CoalescePolicy policy;
+                QC::u64 merged;
+            };
+
             // Event queues
+            IngressRing m_ingress;          // Written by any context, drained by processEvents
+            IngressRing m_immediateIngress; // Immediate events, kept clear of main-queue back-pressure
             EventQueue m_mainQueue;
             ImmediateQueue m_immediateQueue;
 
-            // Listener storage
-            EventListener m_listeners[MaxListeners];
+            // Listener storage (slot order == dispatch order; free slots have id 0)
+            QC::Vector<EventListener> m_listeners;
             QC::usize m_listenerCount = 0;
             ListenerId m_nextListenerId = 1;
 
-            // Receiver storage (for class-based listeners)
-            IEventReceiver *m_receivers[MaxListeners] = {};
+            // Receiver storage (for class-based listeners; free slots are nullptr)
+            QC::Vector<IEventReceiver *> m_receivers;
             QC::usize m_receiverCount = 0;
 
+            // Dispatch indexes: ascending slot numbers of enabled listeners.
+            // Typed listeners live in m_typeIndex; untyped ones under each
+            // category bit of their mask. m_allIndex backs multi-bit categories.
+            QC::Vector<QC::u32> m_typeIndex[TypeIndexBuckets];
+            QC::Vector<QC::u32> m_categoryIndex[CategoryIndexBits];
+            QC::Vector<QC::u32> m_allIndex;
+            QC::Vector<QC::u32> m_receiverOrder;
+            QC::u32 m_dispatchDepth = 0;
+            bool m_indexDirty = false;
+
+            // Coalescing rules (applied when draining ingress into m_mainQueue)
+            CoalesceRule m_coalesceRules[MaxCoalesceRules] = {};
+            QC::usize m_coalesceRuleCount = 0;
+
             // Statistics
             QC::u64 m_totalDispatched = 0;
             QC::u64 m_totalDropped = 0;
+            QC::u64 m_totalCoalesced = 0;
+
+            // Time source
+            QC::u64 m_timestampFrequency = 0;
 
             bool m_initialized = false;
             bool m_dispatching = false; // Prevent re-entrancy issues
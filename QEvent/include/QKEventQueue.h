@@ -11,6 +11,16 @@ namespace QK
     namespace Event
     {
 
+        /// How a newly queued event may merge with one already in the queue
+        enum class CoalescePolicy : QC::u8
+        {
+            None = 0,         // Always queue a new entry
+            MergeConsecutive, // Merge into the tail entry of the same type: latest position, summed deltas
+            Accumulate,       // Merge into the tail entry of the same type: summed scroll delta
+            FoldByKey         // Fold into any queued entry with the same type and key
+                              // (windowId for window events, param1 for custom events)
+        };
+
         /// Circular buffer event queue with priority support
         class EventQueue
         {
@@ -61,7 +71,16 @@ namespace QK
             /// Clear all events in a specific category
             void clearCategory(Category category);
 
+            /// Try to merge an event into one already queued
+            /// @param event The incoming event
+            /// @param policy How the event may be merged
+            /// @return true if the event was absorbed (nothing to push)
+            bool coalesce(const Event &event, CoalescePolicy policy);
+
         private:
+            /// Merge the payload of an incoming event into a queued one
+            static void mergeInto(Event &queued, const Event &incoming, CoalescePolicy policy);
+
             /// Find the insertion index for priority ordering
             QC::usize findInsertIndex(Priority priority) const;
 
@@ -85,6 +104,7 @@ namespace QK
             bool push(const Event &event);
             bool pop(Event &outEvent);
             bool isEmpty() const { return m_count == 0; }
+            bool isFull() const { return m_count >= MaxEvents; }
             void clear();
 
         private:
@@ -95,5 +115,57 @@ namespace QK
             bool m_initialized = false;
         };
 
+        /// Lock-free multi-producer / single-consumer ingress ring.
+        /// Drivers may push from any CPU or from IRQ context; a producer never
+        /// waits on another producer (a preempted slot simply stays unpublished).
+        /// Only the EventManager's dispatch path pops, in batches.
+        class IngressRing
+        {
+        public:
+            /// Capacity (must be a power of two)
+            static constexpr QC::usize Capacity = 256;
+
+            IngressRing() = default;
+
+            // Non-copyable
+            IngressRing(const IngressRing &) = delete;
+            IngressRing &operator=(const IngressRing &) = delete;
+
+            /// Initialize the ring (not safe against concurrent producers)
+            void initialize();
+
+            /// Push an event (any context). Stamps the ingress TSC when the
+            /// event carries no timestamp.
+            /// @return false if the ring is full
+            bool push(const Event &event);
+
+            /// Pop the oldest published event (consumer only)
+            bool pop(Event &outEvent);
+
+            /// Copy the oldest published event without removing it (consumer only)
+            bool peek(Event &outEvent) const;
+
+            /// Check if the ring has no published events (approximate under concurrency)
+            bool isEmpty() const;
+
+            /// Approximate number of reserved slots
+            QC::usize count() const;
+
+            /// Discard all published events (consumer only)
+            void clear();
+
+        private:
+            struct alignas(64) Cell
+            {
+                QC::u64 sequence;
+                Event event;
+            };
+
+            Cell m_cells[Capacity];
+            alignas(64) QC::u64 m_enqueuePos = 0;
+            alignas(64) QC::u64 m_dequeuePos = 0;
+            bool m_initialized = false;
+        };
+
     } // namespace Event
 } // namespace QK
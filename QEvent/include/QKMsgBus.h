@@ -47,10 +47,17 @@ namespace QK
 
             void *payload = nullptr;
             void (*destroyPayload)(void *) = nullptr;
+            QC::usize payloadSize = 0;    // Optional payload length in bytes
+            bool payloadBorrowed = false; // Caller-owned view, valid only during delivery
 
             QC::u32 refCount = 1;
         };
 
+        // Envelope storage: a fixed pool, falling back to the heap when exhausted.
+        // Like subscriptions, intended for the event-processing thread.
+        Envelope *allocateEnvelope();
+        void freeEnvelope(Envelope *env);
+
         inline Envelope *retain(Envelope *env)
         {
             if (env)
@@ -73,18 +80,24 @@ namespace QK
                 return;
             }
 
-            if (env->destroyPayload && env->payload)
+            if (env->destroyPayload && env->payload && !env->payloadBorrowed)
             {
                 env->destroyPayload(env->payload);
             }
 
-            operator delete(env);
+            freeEnvelope(env);
         }
 
         using Handler = void (*)(Envelope *env, void *userData);
         using SubscriptionId = QC::u32;
 
-        class Bus : public QK::Event::IEventReceiver
+        enum class Delivery : QC::u8
+        {
+            Queued = 0, // Through the QEvent queue, delivered by processEvents()
+            Direct = 1  // Synchronously on the publishing CPU, skipping the event queue
+        };
+
+        class Bus
         {
         public:
             static Bus &instance();
@@ -95,38 +108,53 @@ namespace QK
             bool unsubscribe(SubscriptionId id);
 
             // Publishes a message. Bus takes one reference and releases after delivery.
-            bool publish(Envelope *env);
+            // Envelopes with a borrowed payload are always delivered directly.
+            bool publish(Envelope *env, Delivery delivery = Delivery::Queued);
 
-            // QK::Event::IEventReceiver
-            bool onEvent(const QK::Event::Event &event) override;
-            QK::Event::Category getEventMask() const override { return QK::Event::Category::Custom; }
+            // Publishes a caller-owned payload without copying it (e.g. command output).
+            // Delivery is direct; subscribers must copy what they keep, and
+            // env->payload is cleared once delivery returns.
+            bool publishBorrowed(Envelope *env, const void *data, QC::usize size);
 
-            bool isRegistered() const { return m_receiverId != QK::Event::InvalidListenerId; }
+            // Called for the bus' custom event type by the event manager.
+            bool onEvent(const QK::Event::Event &event);
+
+            bool isRegistered() const { return m_listenerId != QK::Event::InvalidListenerId; }
 
         private:
             Bus();
 
             void ensureRegistered();
 
+            // Invoke every subscriber of env->topic
+            void deliver(Envelope *env);
+
+            static QC::usize topicBucket(QC::u32 topic);
+
+            static constexpr QC::u16 NoSub = 0xFFFF;
+
             struct Sub
             {
                 SubscriptionId id = 0;
                 QC::u32 topic = 0;
                 Handler handler = nullptr;
                 void *userData = nullptr;
+                QC::u16 next = NoSub; // Next slot in the same topic bucket (ascending)
                 bool used = false;
             };
 
             static constexpr QC::usize MaxSubs = 64;
+            static constexpr QC::usize TopicBuckets = 32;
             Sub m_subs[MaxSubs];
+            QC::u16 m_bucketHead[TopicBuckets];
             SubscriptionId m_nextId = 1;
 
-            QK::Event::ListenerId m_receiverId = QK::Event::InvalidListenerId;
+            QK::Event::ListenerId m_listenerId = QK::Event::InvalidListenerId;
         };
 
         inline Envelope *makeEnvelope(QC::u32 topic, QC::u64 correlationId = 0)
         {
-            Envelope *env = static_cast<Envelope *>(operator new(sizeof(Envelope)));
+            Envelope *env = allocateEnvelope();
             *env = Envelope{};
             env->topic = topic;
             env->correlationId = correlationId;
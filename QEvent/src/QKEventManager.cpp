@@ -31,6 +31,8 @@ namespace QK
 
             m_mainQueue.initialize();
             m_immediateQueue.initialize();
+            m_ingress.initialize();
+            m_immediateIngress.initialize();
 
             m_listenerCount = 0;
             m_nextListenerId = 1;
@@ -38,20 +40,16 @@ namespace QK
 
             m_totalDispatched = 0;
             m_totalDropped = 0;
+            m_totalCoalesced = 0;
             m_dispatching = false;
+            m_dispatchDepth = 0;
+            resetCoalesceRules();
 
-            // Clear listener array - direct member init (copy assignment crashes in freestanding env)
-            for (QC::usize i = 0; i < MaxListeners; i++)
-            {
-                m_listeners[i].id = 0;
-                m_listeners[i].eventType = Type::None;
-                m_listeners[i].categoryMask = Category::All;
-                m_listeners[i].minPriority = Priority::Low;
-                m_listeners[i].handler = nullptr;
-                m_listeners[i].userData = nullptr;
-                m_listeners[i].enabled = true;
-                m_receivers[i] = nullptr;
-            }
+            m_listeners.clear();
+            m_listeners.reserve(InitialListenerCapacity);
+            m_receivers.clear();
+            m_receivers.reserve(InitialListenerCapacity);
+            rebuildIndex();
 
             m_initialized = true;
             QC_LOG_INFO("QKEvent", "Event Manager initialized");
@@ -67,8 +65,11 @@ namespace QK
             QC_LOG_INFO("QKEvent", "Shutting down Event Manager");
 
             clearEvents();
+            m_listeners.clear();
+            m_receivers.clear();
             m_listenerCount = 0;
             m_receiverCount = 0;
+            rebuildIndex();
             m_initialized = false;
         }
 
@@ -81,21 +82,14 @@ namespace QK
                 return false;
             }
 
-            // Immediate priority bypasses the queue
-            if (event.priority() == Priority::Immediate)
+            // Producers (drivers, IRQ handlers, other CPUs) only touch the
+            // lock-free ingress rings; the queues are owned by processEvents().
+            // Immediate events get their own ring so a full main queue never
+            // holds them back.
+            IngressRing &ring = event.priority() == Priority::Immediate ? m_immediateIngress : m_ingress;
+            if (!ring.push(event))
             {
-                if (!m_immediateQueue.push(event))
-                {
-                    m_totalDropped++;
-                    return false;
-                }
-                return true;
-            }
-
-            if (!m_mainQueue.push(event))
-            {
-                m_totalDropped++;
-                QC_LOG_DEBUG("QKEvent", "Event dropped - queue full");
+                __atomic_fetch_add(&m_totalDropped, 1, __ATOMIC_RELAXED);
                 return false;
             }
 
@@ -242,6 +236,33 @@ namespace QK
         // ==================== Event Processing ====================
 
         QC::usize EventManager::processEvents(QC::usize maxEvents)
+        {
+            return processQueued(maxEvents, 0);
+        }
+
+        QC::usize EventManager::processEventsUntil(QC::u64 timeoutMs)
+        {
+            if (m_timestampFrequency == 0)
+            {
+                // No calibrated time source: behave like an unbounded pass
+                return processQueued(0, 0);
+            }
+
+            QC::u64 ticksPerMs = m_timestampFrequency / 1000;
+            return processQueued(0, getTimestamp() + timeoutMs * ticksPerMs);
+        }
+
+        QC::usize EventManager::processEventsUntilDeadline(QC::u64 deadlineTsc)
+        {
+            return processQueued(0, deadlineTsc);
+        }
+
+        void EventManager::setTimestampFrequency(QC::u64 ticksPerSecond)
+        {
+            m_timestampFrequency = ticksPerSecond;
+        }
+
+        QC::usize EventManager::processQueued(QC::usize maxEvents, QC::u64 deadlineTsc)
         {
             if (!m_initialized || m_dispatching)
             {
@@ -251,17 +272,26 @@ namespace QK
             m_dispatching = true;
             QC::usize processed = 0;
 
-            // Process immediate queue first
+            // Pull everything producers published since the last pass
+            drainIngress();
+
+            // Process main queue (refilled from ingress as handlers post more).
+            // Immediate events, including any the last handler posted, always
+            // go before the next main-queue event.
             Event event;
-            while (m_immediateQueue.pop(event))
+            for (;;)
             {
-                dispatchEvent(event);
-                processed++;
-            }
+                processed += processImmediateEvents();
+
+                if (!m_mainQueue.pop(event))
+                {
+                    if (drainIngress() == 0)
+                    {
+                        break;
+                    }
+                    continue;
+                }
 
-            // Process main queue
-            while (m_mainQueue.pop(event))
-            {
                 dispatchEvent(event);
                 processed++;
 
@@ -269,62 +299,142 @@ namespace QK
                 {
                     break;
                 }
+
+                // Out of budget: the rest stays queued for the next pass. The main
+                // queue is priority-ordered, so what is left is the least urgent.
+                if (deadlineTsc != 0 && getTimestamp() >= deadlineTsc)
+                {
+                    break;
+                }
             }
 
             m_dispatching = false;
             return processed;
         }
 
-        QC::usize EventManager::processEventsUntil(QC::u64 timeoutMs)
-        {
-            // TODO: Implement proper timing when timer is available
-            // For now, just process all events
-            return processEvents(0);
-        }
-
         bool EventManager::hasPendingEvents() const
         {
-            return !m_mainQueue.isEmpty() || !m_immediateQueue.isEmpty();
+            return !m_mainQueue.isEmpty() || !m_immediateQueue.isEmpty() || !m_ingress.isEmpty() ||
+                   !m_immediateIngress.isEmpty();
         }
 
         QC::usize EventManager::pendingEventCount() const
         {
-            return m_mainQueue.count() + (m_immediateQueue.isEmpty() ? 0 : 1);
+            return m_mainQueue.count() + (m_immediateQueue.isEmpty() ? 0 : 1) + m_ingress.count() +
+                   m_immediateIngress.count();
         }
 
         void EventManager::clearEvents()
         {
+            m_ingress.clear();
+            m_immediateIngress.clear();
             m_mainQueue.clear();
             m_immediateQueue.clear();
         }
 
         void EventManager::clearEventsOfType(Type type)
         {
+            drainIngress();
             m_mainQueue.clearType(type);
         }
 
+        // ==================== Coalescing ====================
+
+        bool EventManager::setCoalescePolicy(Type type, CoalescePolicy policy)
+        {
+            for (QC::usize i = 0; i < m_coalesceRuleCount; i++)
+            {
+                if (m_coalesceRules[i].type == type)
+                {
+                    if (policy == CoalescePolicy::None)
+                    {
+                        m_coalesceRules[i] = m_coalesceRules[--m_coalesceRuleCount];
+                    }
+                    else
+                    {
+                        m_coalesceRules[i].policy = policy;
+                    }
+                    return true;
+                }
+            }
+
+            if (policy == CoalescePolicy::None)
+            {
+                return true;
+            }
+
+            if (m_coalesceRuleCount >= MaxCoalesceRules)
+            {
+                return false;
+            }
+
+            m_coalesceRules[m_coalesceRuleCount++] = CoalesceRule{type, policy, 0};
+            return true;
+        }
+
+        CoalescePolicy EventManager::coalescePolicy(Type type) const
+        {
+            for (QC::usize i = 0; i < m_coalesceRuleCount; i++)
+            {
+                if (m_coalesceRules[i].type == type)
+                {
+                    return m_coalesceRules[i].policy;
+                }
+            }
+            return CoalescePolicy::None;
+        }
+
+        QC::u64 EventManager::eventsCoalesced(Type type) const
+        {
+            for (QC::usize i = 0; i < m_coalesceRuleCount; i++)
+            {
+                if (m_coalesceRules[i].type == type)
+                {
+                    return m_coalesceRules[i].merged;
+                }
+            }
+            return 0;
+        }
+
+        void EventManager::resetCoalesceRules()
+        {
+            m_coalesceRuleCount = 0;
+            setCoalescePolicy(Type::MouseMove, CoalescePolicy::MergeConsecutive);
+            setCoalescePolicy(Type::MouseScroll, CoalescePolicy::Accumulate);
+            setCoalescePolicy(Type::WindowMove, CoalescePolicy::FoldByKey);
+            setCoalescePolicy(Type::WindowResize, CoalescePolicy::FoldByKey);
+            setCoalescePolicy(Type::WindowPaint, CoalescePolicy::FoldByKey);
+        }
+
         // ==================== Listener Management ====================
 
         ListenerId EventManager::addListener(const EventListener &listener)
         {
-            if (!m_initialized || m_listenerCount >= MaxListeners)
+            if (!m_initialized)
             {
                 return InvalidListenerId;
             }
 
-            // Find empty slot
-            for (QC::usize i = 0; i < MaxListeners; i++)
+            // Reuse the first empty slot, otherwise grow
+            QC::usize slot = m_listeners.size();
+            for (QC::usize i = 0; i < m_listeners.size(); i++)
             {
                 if (m_listeners[i].id == InvalidListenerId)
                 {
-                    m_listeners[i] = listener;
-                    m_listeners[i].id = nextListenerId();
-                    m_listenerCount++;
-                    return m_listeners[i].id;
+                    slot = i;
+                    break;
                 }
             }
+            if (slot == m_listeners.size())
+            {
+                m_listeners.push_back(EventListener());
+            }
 
-            return InvalidListenerId;
+            m_listeners[slot] = listener;
+            m_listeners[slot].id = nextListenerId();
+            m_listenerCount++;
+            invalidateIndex();
+            return m_listeners[slot].id;
         }
 
         ListenerId EventManager::addListener(Type type, EventHandler handler, void *userData)
@@ -341,24 +451,35 @@ namespace QK
 
         ListenerId EventManager::addReceiver(IEventReceiver *receiver)
         {
-            if (!m_initialized || receiver == nullptr || m_receiverCount >= MaxListeners)
+            if (!m_initialized || receiver == nullptr)
             {
                 return InvalidListenerId;
             }
 
-            // Find empty slot
-            for (QC::usize i = 0; i < MaxListeners; i++)
+            // Reuse the first empty slot, otherwise grow
+            QC::usize slot = m_receivers.size();
+            for (QC::usize i = 0; i < m_receivers.size(); i++)
             {
                 if (m_receivers[i] == nullptr)
                 {
-                    m_receivers[i] = receiver;
-                    m_receiverCount++;
-                    // Return a pseudo-ID for receivers (high bit set)
-                    return static_cast<ListenerId>(0x80000000 | i);
+                    slot = i;
+                    break;
                 }
             }
+            if (slot == m_receivers.size())
+            {
+                if (slot >= 0x7FFFFFFF)
+                {
+                    return InvalidListenerId;
+                }
+                m_receivers.push_back(nullptr);
+            }
 
-            return InvalidListenerId;
+            m_receivers[slot] = receiver;
+            m_receiverCount++;
+            invalidateIndex();
+            // Return a pseudo-ID for receivers (high bit set)
+            return static_cast<ListenerId>(0x80000000 | slot);
         }
 
         void EventManager::removeListener(ListenerId id)
@@ -372,21 +493,23 @@ namespace QK
             if (id & 0x80000000)
             {
                 QC::usize idx = id & 0x7FFFFFFF;
-                if (idx < MaxListeners && m_receivers[idx] != nullptr)
+                if (idx < m_receivers.size() && m_receivers[idx] != nullptr)
                 {
                     m_receivers[idx] = nullptr;
                     m_receiverCount--;
+                    invalidateIndex();
                 }
                 return;
             }
 
             // Find and remove listener
-            for (QC::usize i = 0; i < MaxListeners; i++)
+            for (QC::usize i = 0; i < m_listeners.size(); i++)
             {
                 if (m_listeners[i].id == id)
                 {
                     m_listeners[i] = EventListener();
                     m_listenerCount--;
+                    invalidateIndex();
                     return;
                 }
             }
@@ -394,22 +517,30 @@ namespace QK
 
         void EventManager::removeListenersForHandler(EventHandler handler)
         {
-            for (QC::usize i = 0; i < MaxListeners; i++)
+            bool removed = false;
+            for (QC::usize i = 0; i < m_listeners.size(); i++)
             {
-                if (m_listeners[i].handler == handler)
+                if (m_listeners[i].id != InvalidListenerId && m_listeners[i].handler == handler)
                 {
                     m_listeners[i] = EventListener();
                     m_listenerCount--;
+                    removed = true;
                 }
             }
+
+            if (removed)
+            {
+                invalidateIndex();
+            }
         }
 
         void EventManager::setListenerEnabled(ListenerId id, bool enabled)
         {
             EventListener *listener = findListener(id);
-            if (listener)
+            if (listener && listener->enabled != enabled)
             {
                 listener->enabled = enabled;
+                invalidateIndex();
             }
         }
 
@@ -424,6 +555,11 @@ namespace QK
         {
             m_totalDispatched = 0;
             m_totalDropped = 0;
+            m_totalCoalesced = 0;
+            for (QC::usize i = 0; i < m_coalesceRuleCount; i++)
+            {
+                m_coalesceRules[i].merged = 0;
+            }
         }
 
         // ==================== Private Methods ====================
@@ -432,74 +568,264 @@ namespace QK
         {
             m_totalDispatched++;
 
-            // Dispatch to function listeners
-            for (QC::usize i = 0; i < MaxListeners; i++)
+            // Index vectors must stay stable while handlers run (they may add or
+            // remove listeners); rebuilds are deferred to the outermost dispatch.
+            m_dispatchDepth++;
+
+            bool consumed = false;
+            const QC::u8 cat = static_cast<QC::u8>(event.category());
+            const QC::Vector<QC::u32> &typed = m_typeIndex[typeBucket(event.type())];
+
+            if (cat != 0 && (cat & (cat - 1)) == 0)
             {
-                const EventListener &listener = m_listeners[i];
+                // Merge typed and category lists in slot order to keep the
+                // registration-order semantics of the original linear scan.
+                const QC::Vector<QC::u32> &byCategory = m_categoryIndex[__builtin_ctz(cat)];
+                QC::usize t = 0;
+                QC::usize c = 0;
+                while (!consumed && (t < typed.size() || c < byCategory.size()))
+                {
+                    QC::u32 slot;
+                    if (c >= byCategory.size() || (t < typed.size() && typed[t] < byCategory[c]))
+                    {
+                        slot = typed[t++];
+                    }
+                    else
+                    {
+                        slot = byCategory[c++];
+                    }
+                    consumed = dispatchToListener(slot, event);
+                }
+            }
+            else if (cat != 0)
+            {
+                // Multi-bit category: fall back to every enabled listener
+                for (QC::usize i = 0; !consumed && i < m_allIndex.size(); i++)
+                {
+                    consumed = dispatchToListener(m_allIndex[i], event);
+                }
+            }
 
-                if (listener.id == InvalidListenerId || !listener.enabled)
+            // Dispatch to class receivers
+            for (QC::usize i = 0; !consumed && i < m_receiverOrder.size(); i++)
+            {
+                QC::u32 slot = m_receiverOrder[i];
+                IEventReceiver *receiver = (slot < m_receivers.size()) ? m_receivers[slot] : nullptr;
+
+                if (receiver == nullptr || !receiver->isEnabled())
                 {
                     continue;
                 }
 
-                // Check type filter
-                if (listener.eventType != Type::None && listener.eventType != event.type())
+                // Check category filter
+                if (!hasCategory(event.category(), receiver->getEventMask()))
                 {
                     continue;
                 }
 
-                // Check category filter
-                if (!hasCategory(event.category(), listener.categoryMask))
+                consumed = receiver->onEvent(event);
+            }
+
+            m_dispatchDepth--;
+            if (m_dispatchDepth == 0 && m_indexDirty)
+            {
+                rebuildIndex();
+            }
+        }
+
+        bool EventManager::dispatchToListener(QC::u32 slot, const Event &event)
+        {
+            // Re-read the slot: a handler may have removed or replaced it
+            if (slot >= m_listeners.size())
+            {
+                return false;
+            }
+
+            const EventListener &listener = m_listeners[slot];
+
+            if (listener.id == InvalidListenerId || !listener.enabled || !listener.handler)
+            {
+                return false;
+            }
+
+            // Check type filter
+            if (listener.eventType != Type::None && listener.eventType != event.type())
+            {
+                return false;
+            }
+
+            // Check category filter
+            if (!hasCategory(event.category(), listener.categoryMask))
+            {
+                return false;
+            }
+
+            // Check priority filter
+            if (event.priority() < listener.minPriority)
+            {
+                return false;
+            }
+
+            // Copy out before calling: the handler may grow m_listeners
+            EventHandler handler = listener.handler;
+            void *userData = listener.userData;
+            return handler(event, userData);
+        }
+
+        void EventManager::invalidateIndex()
+        {
+            m_indexDirty = true;
+            if (m_dispatchDepth == 0)
+            {
+                rebuildIndex();
+            }
+        }
+
+        void EventManager::rebuildIndex()
+        {
+            for (QC::usize b = 0; b < TypeIndexBuckets; b++)
+            {
+                m_typeIndex[b].clear();
+            }
+            for (QC::usize b = 0; b < CategoryIndexBits; b++)
+            {
+                m_categoryIndex[b].clear();
+            }
+            m_allIndex.clear();
+            m_receiverOrder.clear();
+
+            for (QC::usize i = 0; i < m_listeners.size(); i++)
+            {
+                const EventListener &listener = m_listeners[i];
+                if (listener.id == InvalidListenerId || !listener.enabled)
                 {
                     continue;
                 }
 
-                // Check priority filter
-                if (event.priority() < listener.minPriority)
+                const QC::u32 slot = static_cast<QC::u32>(i);
+                m_allIndex.push_back(slot);
+
+                if (listener.eventType != Type::None)
                 {
+                    m_typeIndex[typeBucket(listener.eventType)].push_back(slot);
                     continue;
                 }
 
-                // Call handler
-                if (listener.handler)
+                const QC::u8 mask = static_cast<QC::u8>(listener.categoryMask);
+                for (QC::usize bit = 0; bit < CategoryIndexBits; bit++)
                 {
-                    bool handled = listener.handler(event, listener.userData);
-                    if (handled)
+                    if (mask & (1u << bit))
                     {
-                        return; // Event consumed
+                        m_categoryIndex[bit].push_back(slot);
                     }
                 }
             }
 
-            // Dispatch to class receivers
-            for (QC::usize i = 0; i < MaxListeners; i++)
+            for (QC::usize i = 0; i < m_receivers.size(); i++)
             {
-                IEventReceiver *receiver = m_receivers[i];
+                if (m_receivers[i] != nullptr)
+                {
+                    m_receiverOrder.push_back(static_cast<QC::u32>(i));
+                }
+            }
 
-                if (receiver == nullptr || !receiver->isEnabled())
+            m_indexDirty = false;
+        }
+
+        QC::usize EventManager::typeBucket(Type type)
+        {
+            // Fibonacci hash spreads the clustered type ranges (100s, 300s, ...)
+            QC::u32 h = static_cast<QC::u32>(type) * 0x9E3779B1u;
+            return (h >> 26) & (TypeIndexBuckets - 1);
+        }
+
+        QC::usize EventManager::drainIngress()
+        {
+            QC::usize moved = drainImmediateIngress();
+            Event event;
+
+            // Look before popping: an event that merges into a queued entry
+            // needs no slot, so only new entries wait on a full main queue
+            // (back-pressure keeps them in the ring instead of dropping them).
+            while (m_ingress.peek(event))
+            {
+                // High-rate events merge into what is already queued, so a
+                // flood costs one dispatch instead of one per packet.
+                if (m_coalesceRuleCount > 0)
                 {
-                    continue;
+                    CoalesceRule *rule = nullptr;
+                    for (QC::usize i = 0; i < m_coalesceRuleCount; i++)
+                    {
+                        if (m_coalesceRules[i].type == event.type())
+                        {
+                            rule = &m_coalesceRules[i];
+                            break;
+                        }
+                    }
+
+                    if (rule && m_mainQueue.coalesce(event, rule->policy))
+                    {
+                        m_ingress.pop(event);
+                        rule->merged++;
+                        m_totalCoalesced++;
+                        moved++;
+                        continue;
+                    }
                 }
 
-                // Check category filter
-                if (!hasCategory(event.category(), receiver->getEventMask()))
+                if (m_mainQueue.isFull())
                 {
+                    break;
+                }
+
+                m_ingress.pop(event);
+                if (!m_mainQueue.push(event))
+                {
+                    __atomic_fetch_add(&m_totalDropped, 1, __ATOMIC_RELAXED);
                     continue;
                 }
+                moved++;
+            }
+
+            return moved;
+        }
 
-                bool handled = receiver->onEvent(event);
-                if (handled)
+        QC::usize EventManager::drainImmediateIngress()
+        {
+            // Immediate events wait in their ring only while the small
+            // immediate queue is full; processQueued empties it constantly.
+            QC::usize moved = 0;
+            Event event;
+            while (!m_immediateQueue.isFull() && m_immediateIngress.pop(event))
+            {
+                m_immediateQueue.push(event);
+                moved++;
+            }
+            return moved;
+        }
+
+        QC::usize EventManager::processImmediateEvents()
+        {
+            QC::usize dispatched = 0;
+            Event event;
+            for (;;)
+            {
+                // Refill as we go: handlers may post more Immediate events.
+                if (!m_immediateQueue.pop(event) && (drainImmediateIngress() == 0 || !m_immediateQueue.pop(event)))
                 {
-                    return; // Event consumed
+                    break;
                 }
+
+                dispatchEvent(event);
+                dispatched++;
             }
+            return dispatched;
         }
 
         QC::u64 EventManager::getTimestamp() const
         {
-            // TODO: Get actual system tick count when timer is available
-            static QC::u64 s_counter = 0;
-            return ++s_counter;
+            // TSC: lock-free and safe from IRQ context (unlike a shared counter)
+            return QC::rdtsc();
         }
 
         ListenerId EventManager::nextListenerId()
@@ -514,7 +840,7 @@ namespace QK
                 return nullptr;
             }
 
-            for (QC::usize i = 0; i < MaxListeners; i++)
+            for (QC::usize i = 0; i < m_listeners.size(); i++)
             {
                 if (m_listeners[i].id == id)
                 {
@@ -532,7 +858,7 @@ namespace QK
                 return nullptr;
             }
 
-            for (QC::usize i = 0; i < MaxListeners; i++)
+            for (QC::usize i = 0; i < m_listeners.size(); i++)
             {
                 if (m_listeners[i].id == id)
                 {
@@ -153,6 +153,104 @@ namespace QK
             }
         }
 
+        bool EventQueue::coalesce(const Event &event, CoalescePolicy policy)
+        {
+            if (!m_initialized || isEmpty() || policy == CoalescePolicy::None)
+            {
+                return false;
+            }
+
+            if (policy == CoalescePolicy::MergeConsecutive || policy == CoalescePolicy::Accumulate)
+            {
+                // Only the most recently queued entry: never reorder across other events
+                QC::usize last = (m_tail == 0) ? MaxEvents - 1 : m_tail - 1;
+                Event &queued = m_events[last];
+                if (queued.type() != event.type() || queued.priority() != event.priority())
+                {
+                    return false;
+                }
+
+                mergeInto(queued, event, policy);
+                return true;
+            }
+
+            // FoldByKey: any queued entry with the same type and key
+            QC::usize current = m_head;
+            for (QC::usize i = 0; i < m_count; i++)
+            {
+                Event &queued = m_events[current];
+                if (queued.type() == event.type() && queued.priority() == event.priority())
+                {
+                    bool sameKey = false;
+                    if (event.category() == Category::Window)
+                    {
+                        sameKey = queued.asWindow().windowId == event.asWindow().windowId;
+                    }
+                    else if (event.category() == Category::Custom)
+                    {
+                        sameKey = queued.asCustom().param1 == event.asCustom().param1;
+                    }
+
+                    if (sameKey)
+                    {
+                        mergeInto(queued, event, policy);
+                        return true;
+                    }
+                }
+                current = (current + 1) % MaxEvents;
+            }
+
+            return false;
+        }
+
+        void EventQueue::mergeInto(Event &queued, const Event &incoming, CoalescePolicy policy)
+        {
+            // Keep the oldest timestamp so latency measurements see the first packet
+            QC::u64 firstTimestamp = queued.timestamp();
+
+            if (policy == CoalescePolicy::MergeConsecutive)
+            {
+                QC::i32 deltaX = queued.asMouse().deltaX + incoming.asMouse().deltaX;
+                QC::i32 deltaY = queued.asMouse().deltaY + incoming.asMouse().deltaY;
+                queued = incoming;
+                queued.asMouse().deltaX = deltaX;
+                queued.asMouse().deltaY = deltaY;
+            }
+            else if (policy == CoalescePolicy::Accumulate)
+            {
+                QC::i32 scroll = queued.asMouse().scrollDelta + incoming.asMouse().scrollDelta;
+                queued = incoming;
+                queued.asMouse().scrollDelta = scroll;
+            }
+            else if (incoming.type() == Type::WindowPaint)
+            {
+                // Repaint requests: union of both rectangles
+                WindowEventData &a = queued.asWindow();
+                const WindowEventData &b = incoming.asWindow();
+                QC::i32 left = (a.x < b.x) ? a.x : b.x;
+                QC::i32 top = (a.y < b.y) ? a.y : b.y;
+                QC::i64 right = static_cast<QC::i64>(a.x) + a.width;
+                QC::i64 bottom = static_cast<QC::i64>(a.y) + a.height;
+                QC::i64 bRight = static_cast<QC::i64>(b.x) + b.width;
+                QC::i64 bBottom = static_cast<QC::i64>(b.y) + b.height;
+                if (bRight > right)
+                    right = bRight;
+                if (bBottom > bottom)
+                    bottom = bBottom;
+                a.x = left;
+                a.y = top;
+                a.width = static_cast<QC::u32>(right - left);
+                a.height = static_cast<QC::u32>(bottom - top);
+            }
+            else
+            {
+                // Latest state wins (window move/resize, keyed custom events)
+                queued = incoming;
+            }
+
+            queued.base().timestamp = firstTimestamp;
+        }
+
         QC::usize EventQueue::findInsertIndex(Priority priority) const
         {
             // Find first event with lower priority than the new one
@@ -211,5 +309,124 @@ namespace QK
             m_count = 0;
         }
 
+        // ==================== IngressRing Implementation ====================
+
+        void IngressRing::initialize()
+        {
+            for (QC::usize i = 0; i < Capacity; i++)
+            {
+                __atomic_store_n(&m_cells[i].sequence, static_cast<QC::u64>(i), __ATOMIC_RELAXED);
+            }
+            __atomic_store_n(&m_enqueuePos, 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&m_dequeuePos, 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&m_initialized, true, __ATOMIC_RELEASE);
+        }
+
+        bool IngressRing::push(const Event &event)
+        {
+            if (!__atomic_load_n(&m_initialized, __ATOMIC_ACQUIRE))
+            {
+                return false;
+            }
+
+            // Reserve a slot: the CAS only fails when another producer made progress.
+            QC::u64 pos = __atomic_load_n(&m_enqueuePos, __ATOMIC_RELAXED);
+            Cell *cell = nullptr;
+            for (;;)
+            {
+                cell = &m_cells[pos & (Capacity - 1)];
+                QC::u64 seq = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+                QC::i64 diff = static_cast<QC::i64>(seq) - static_cast<QC::i64>(pos);
+
+                if (diff == 0)
+                {
+                    if (__atomic_compare_exchange_n(&m_enqueuePos, &pos, pos + 1, true,
+                                                    __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                    {
+                        break;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false; // Full: consumer has not released this slot yet
+                }
+                else
+                {
+                    pos = __atomic_load_n(&m_enqueuePos, __ATOMIC_RELAXED);
+                }
+            }
+
+            cell->event = event;
+            if (cell->event.data.base.timestamp == 0)
+            {
+                cell->event.data.base.timestamp = QC::rdtsc();
+            }
+
+            // Publish to the consumer
+            __atomic_store_n(&cell->sequence, pos + 1, __ATOMIC_RELEASE);
+            return true;
+        }
+
+        bool IngressRing::pop(Event &outEvent)
+        {
+            if (!m_initialized)
+            {
+                return false;
+            }
+
+            QC::u64 pos = __atomic_load_n(&m_dequeuePos, __ATOMIC_RELAXED);
+            Cell &cell = m_cells[pos & (Capacity - 1)];
+            QC::u64 seq = __atomic_load_n(&cell.sequence, __ATOMIC_ACQUIRE);
+            if (seq != pos + 1)
+            {
+                return false; // Empty, or the next producer has not published yet
+            }
+
+            outEvent = cell.event;
+
+            // Hand the slot back to producers for the next lap
+            __atomic_store_n(&cell.sequence, pos + Capacity, __ATOMIC_RELEASE);
+            __atomic_store_n(&m_dequeuePos, pos + 1, __ATOMIC_RELAXED);
+            return true;
+        }
+
+        bool IngressRing::peek(Event &outEvent) const
+        {
+            if (!m_initialized)
+            {
+                return false;
+            }
+
+            QC::u64 pos = __atomic_load_n(&m_dequeuePos, __ATOMIC_RELAXED);
+            const Cell &cell = m_cells[pos & (Capacity - 1)];
+            if (__atomic_load_n(&cell.sequence, __ATOMIC_ACQUIRE) != pos + 1)
+            {
+                return false;
+            }
+
+            outEvent = cell.event;
+            return true;
+        }
+
+        bool IngressRing::isEmpty() const
+        {
+            return count() == 0;
+        }
+
+        QC::usize IngressRing::count() const
+        {
+            QC::u64 head = __atomic_load_n(&m_dequeuePos, __ATOMIC_RELAXED);
+            QC::u64 tail = __atomic_load_n(&m_enqueuePos, __ATOMIC_RELAXED);
+            return tail > head ? static_cast<QC::usize>(tail - head) : 0;
+        }
+
+        void IngressRing::clear()
+        {
+            Event discard;
+            while (pop(discard))
+            {
+            }
+        }
+
     } // namespace Event
 } // namespace QK
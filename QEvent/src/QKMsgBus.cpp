@@ -8,15 +8,66 @@ namespace QK
     {
         namespace
         {
-            inline bool isMsgBusEvent(const QK::Event::Event &event)
+            constexpr QK::Event::Type kBusEventType =
+                static_cast<QK::Event::Type>(static_cast<QC::u16>(QK::Event::Type::CustomBase) + CustomType);
+
+            // Envelope pool: messages are short-lived, so a small free list covers
+            // steady-state traffic without touching the heap.
+            constexpr QC::usize kEnvelopePoolSize = 64;
+
+            struct EnvelopePool
             {
-                if (event.category() != QK::Event::Category::Custom)
-                    return false;
+                Envelope slots[kEnvelopePoolSize];
+                Envelope *freeList[kEnvelopePoolSize];
+                QC::usize freeCount = 0;
+                bool initialized = false;
+
+                void initialize()
+                {
+                    for (QC::usize i = 0; i < kEnvelopePoolSize; ++i)
+                    {
+                        freeList[i] = &slots[kEnvelopePoolSize - 1 - i];
+                    }
+                    freeCount = kEnvelopePoolSize;
+                    initialized = true;
+                }
+
+                bool owns(const Envelope *env) const
+                {
+                    return env >= &slots[0] && env < &slots[kEnvelopePoolSize];
+                }
+            };
+
+            EnvelopePool g_envelopePool;
+        }
+
+        Envelope *allocateEnvelope()
+        {
+            if (!g_envelopePool.initialized)
+            {
+                g_envelopePool.initialize();
+            }
+
+            if (g_envelopePool.freeCount > 0)
+            {
+                return g_envelopePool.freeList[--g_envelopePool.freeCount];
+            }
 
-                const QC::u16 t = static_cast<QC::u16>(event.type());
-                const QC::u16 expected = static_cast<QC::u16>(QK::Event::Type::CustomBase) + CustomType;
-                return t == expected;
+            return static_cast<Envelope *>(operator new(sizeof(Envelope)));
+        }
+
+        void freeEnvelope(Envelope *env)
+        {
+            if (!env)
+                return;
+
+            if (g_envelopePool.owns(env))
+            {
+                g_envelopePool.freeList[g_envelopePool.freeCount++] = env;
+                return;
             }
+
+            operator delete(env);
         }
 
         Bus &Bus::instance()
@@ -31,13 +82,17 @@ namespace QK
             {
                 m_subs[i] = Sub{};
             }
+            for (QC::usize i = 0; i < TopicBuckets; ++i)
+            {
+                m_bucketHead[i] = NoSub;
+            }
 
             ensureRegistered();
         }
 
         void Bus::ensureRegistered()
         {
-            if (m_receiverId != QK::Event::InvalidListenerId)
+            if (m_listenerId != QK::Event::InvalidListenerId)
             {
                 return;
             }
@@ -48,7 +103,21 @@ namespace QK
                 return;
             }
 
-            m_receiverId = eventMgr.addReceiver(this);
+            // A typed listener is found through the dispatch index directly,
+            // instead of after the listener and receiver passes.
+            m_listenerId = eventMgr.addListener(
+                kBusEventType,
+                [](const QK::Event::Event &event, void *userData) -> bool
+                {
+                    return static_cast<Bus *>(userData)->onEvent(event);
+                },
+                this);
+        }
+
+        QC::usize Bus::topicBucket(QC::u32 topic)
+        {
+            // Topics are FourCCs; a multiplicative hash spreads the shared prefixes.
+            return (topic * 0x9E3779B1u) >> 27;
         }
 
         SubscriptionId Bus::subscribe(QC::u32 topic, Handler handler, void *userData)
@@ -67,6 +136,16 @@ namespace QK
                     m_subs[i].topic = topic;
                     m_subs[i].handler = handler;
                     m_subs[i].userData = userData;
+
+                    // Keep each bucket chain in slot order so delivery order matches
+                    // the order of the original slot scan.
+                    QC::u16 *link = &m_bucketHead[topicBucket(topic)];
+                    while (*link != NoSub && *link < i)
+                    {
+                        link = &m_subs[*link].next;
+                    }
+                    m_subs[i].next = *link;
+                    *link = static_cast<QC::u16>(i);
                     return id;
                 }
             }
@@ -83,6 +162,16 @@ namespace QK
             {
                 if (m_subs[i].used && m_subs[i].id == id)
                 {
+                    QC::u16 *link = &m_bucketHead[topicBucket(m_subs[i].topic)];
+                    while (*link != NoSub && *link != i)
+                    {
+                        link = &m_subs[*link].next;
+                    }
+                    if (*link == i)
+                    {
+                        *link = m_subs[i].next;
+                    }
+
                     m_subs[i] = Sub{};
                     return true;
                 }
@@ -91,12 +180,27 @@ namespace QK
             return false;
         }
 
-        bool Bus::publish(Envelope *env)
+        bool Bus::publish(Envelope *env, Delivery delivery)
         {
             ensureRegistered();
             if (!env || env->topic == 0)
                 return false;
 
+            // A borrowed payload must not outlive this call.
+            if (delivery == Delivery::Direct || env->payloadBorrowed)
+            {
+                retain(env);
+                deliver(env);
+                if (env->payloadBorrowed)
+                {
+                    env->payload = nullptr;
+                    env->payloadSize = 0;
+                    env->payloadBorrowed = false;
+                }
+                release(env);
+                return true;
+            }
+
             // The queued event owns one ref until delivery finishes.
             retain(env);
 
@@ -115,9 +219,27 @@ namespace QK
             return true;
         }
 
+        bool Bus::publishBorrowed(Envelope *env, const void *data, QC::usize size)
+        {
+            if (!env)
+                return false;
+
+            // Drop any owned payload first; the view replaces it.
+            if (env->destroyPayload && env->payload && !env->payloadBorrowed)
+            {
+                env->destroyPayload(env->payload);
+            }
+
+            env->payload = const_cast<void *>(data);
+            env->payloadSize = size;
+            env->payloadBorrowed = true;
+            env->destroyPayload = nullptr;
+            return publish(env, Delivery::Direct);
+        }
+
         bool Bus::onEvent(const QK::Event::Event &event)
         {
-            if (!isMsgBusEvent(event))
+            if (event.type() != kBusEventType)
             {
                 return false;
             }
@@ -132,23 +254,43 @@ namespace QK
             env->topic = static_cast<QC::u32>(event.data.custom.param1);
             env->correlationId = event.data.custom.param2;
 
-            for (QC::usize i = 0; i < MaxSubs; ++i)
+            deliver(env);
+
+            // Release the queue's reference.
+            release(env);
+            return true;
+        }
+
+        void Bus::deliver(Envelope *env)
+        {
+            // Snapshot the matching slots: handlers may (un)subscribe. A slot
+            // is only called if it still holds the same subscription, and its
+            // handler/userData are read at call time, so a subscriber removed
+            // by an earlier handler is never called with freed userData.
+            struct Target
             {
-                if (!m_subs[i].used)
-                    continue;
+                QC::u16 slot;
+                SubscriptionId id;
+            };
 
-                if (m_subs[i].topic != env->topic)
-                    continue;
+            Target targets[MaxSubs];
+            QC::usize count = 0;
 
-                if (m_subs[i].handler)
+            for (QC::u16 i = m_bucketHead[topicBucket(env->topic)]; i != NoSub; i = m_subs[i].next)
+            {
+                if (m_subs[i].used && m_subs[i].topic == env->topic && m_subs[i].handler)
                 {
-                    m_subs[i].handler(env, m_subs[i].userData);
+                    targets[count++] = Target{i, m_subs[i].id};
                 }
             }
 
-            // Release the queue's reference.
-            release(env);
-            return true;
+            for (QC::usize i = 0; i < count; ++i)
+            {
+                const Sub &sub = m_subs[targets[i].slot];
+                if (!sub.used || sub.id != targets[i].id || !sub.handler)
+                    continue;
+                sub.handler(env, sub.userData);
+            }
         }
 
     } // namespace Msg
@@ -3,20 +3,48 @@
 #include "QCTypes.h"
 #include "QCVector.h"
 #include "QCGeometry.h"
+#include "QGPixelKernels.h"
 
 namespace QG
 {
     class IPainter;
 
+    /// Alpha coverage of one image row, recorded at load time
+    enum class RowCoverage : QC::u8
+    {
+        Mixed,      // Needs blending
+        Opaque,     // Every pixel has alpha 255: plain copy
+        Transparent // Every pixel is zero: nothing to draw
+    };
+
+    /// One 2x box-filtered reduction of an image
+    struct MipLevel
+    {
+        QC::u32 width = 0;
+        QC::u32 height = 0;
+        QC::Vector<QC::u32> pixels;
+    };
+
     struct ImageSurface
     {
         QC::u32 width = 0;
         QC::u32 height = 0;
         QC::Vector<QC::u32> pixels;
+        SurfaceFormat format = SurfaceFormat::Straight;
+        QC::Vector<RowCoverage> rowCoverage; // Empty until analyzeCoverage()
+        QC::Vector<MipLevel> mips;           // Half size, quarter size, ... down to 1x1
+        QC::u32 serial = 0;                  // Identifies these pixels to ScaledImage; 0 = not cacheable
 
         void reset();
         bool isValid() const;
         const QC::u32 *data() const;
+
+        /// Record per-row coverage; promotes the format to Opaque when every row is
+        void analyzeCoverage();
+        RowCoverage coverage(QC::u32 row) const;
+
+        /// Build the mip chain from the current pixels
+        void buildMips();
     };
 
     enum class ImageScaleMode : QC::u8
@@ -29,6 +57,21 @@ namespace QG
         Tile
     };
 
+    /// The last scaled copy blitImage made of an image. Redrawing the same
+    /// image at the same size and mode blits this copy instead of resampling.
+    struct ScaledImage
+    {
+        QC::u32 serial = 0;
+        QC::u32 width = 0;
+        QC::u32 height = 0;
+        ImageScaleMode mode = ImageScaleMode::Original;
+        ImageSurface surface;
+
+        /// Drop the copy (frees its pixels)
+        void reset();
+    };
+
+    /// Decode an 8-bit greyscale, RGB or RGBA PNG; the result carries its mip chain
     bool decodePNG(const QC::u8 *data, QC::usize size, ImageSurface &outSurface);
     bool decodePNG(const QC::Vector<QC::u8> &buffer, ImageSurface &outSurface);
 
@@ -36,5 +79,5 @@ namespace QG
                    const ImageSurface &surface,
                    const QC::Rect &destination,
                    ImageScaleMode scaleMode,
-                   QC::Vector<QC::u32> &scratchRow);
+                   ScaledImage &cache);
 }
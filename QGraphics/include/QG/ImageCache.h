@@ -0,0 +1,84 @@
+#pragma once
+
+// QGraphics ImageCache - Decoded image assets shared across themes
+// Namespace: QG
+
+#include "QCTypes.h"
+#include "QCVector.h"
+#include "QG/Image.h"
+
+namespace QG
+{
+
+    /// ImageCache - decoded images keyed by path hash plus a caller-supplied
+    /// stamp (file size or modification time) that detects changed files.
+    /// Images handed out are pinned until released; unpinned images stay cached
+    /// within a byte budget and are evicted least recently used first, so
+    /// switching between themes reuses surfaces instead of decoding again.
+    class ImageCache
+    {
+    public:
+        static constexpr QC::usize DefaultBudgetBytes = 24 * 1024 * 1024;
+        static constexpr QC::usize BucketCount = 64;
+        static constexpr QC::usize MaxPathLength = 128;
+
+        static ImageCache &instance();
+
+        /// Cached image for `path`, pinned; nullptr if absent or the stamp changed
+        const ImageSurface *acquire(const char *path, QC::u64 stamp);
+
+        /// Decode a PNG and cache it under (path, stamp)
+        /// @return the image pinned, or nullptr if it does not decode
+        const ImageSurface *insert(const char *path, QC::u64 stamp, const QC::u8 *data, QC::usize size);
+
+        /// Drop one pin taken by acquire()/insert()
+        void release(const ImageSurface *surface);
+
+        /// Evict unpinned images, oldest first, until at most `keepBytes` remain
+        /// @return bytes freed
+        QC::usize trim(QC::usize keepBytes = 0);
+
+        void setBudget(QC::usize bytes);
+        QC::usize budget() const { return m_budgetBytes; }
+        QC::usize cachedBytes() const { return m_cachedBytes; }
+        QC::usize count() const { return m_entries.size(); }
+        QC::u64 hits() const { return m_hits; }
+        QC::u64 misses() const { return m_misses; }
+
+        static QC::u64 hashPath(const char *path);
+
+    private:
+        ImageCache();
+        ImageCache(const ImageCache &) = delete;
+        ImageCache &operator=(const ImageCache &) = delete;
+
+        struct Entry
+        {
+            QC::u64 hash = 0;
+            QC::u64 stamp = 0;
+            char path[MaxPathLength];
+            ImageSurface surface;
+            QC::usize bytes = 0;
+            QC::u32 pins = 0;
+            QC::u64 lastUse = 0;
+            bool linked = false;       // Reachable from the hash table
+            Entry *nextInBucket = nullptr;
+        };
+
+        Entry *find(QC::u64 hash, const char *path) const;
+        void link(Entry *entry);
+        void unlink(Entry *entry);
+        /// Remove from the cache and free; the entry must be unpinned
+        void destroy(Entry *entry);
+        void enforceBudget();
+
+        Entry *m_buckets[BucketCount];
+        QC::Vector<Entry *> m_entries; // Every live entry, for release and eviction scans
+        QC::usize m_cachedBytes = 0;
+        QC::usize m_budgetBytes = DefaultBudgetBytes;
+        QC::u64 m_clock = 0;
+        QC::u64 m_hits = 0;
+        QC::u64 m_misses = 0;
+    };
+
+} // namespace QG
@@ -0,0 +1,91 @@
+#pragma once
+
+// QGraphics NinePatch - Pre-rendered rounded rects and blurred shadows
+// Namespace: QG
+
+#include "QCTypes.h"
+#include "QCVector.h"
+#include "QCGeometry.h"
+#include "QCColor.h"
+
+namespace QG
+{
+
+    /// A shape rendered once at its corner size and stretched to any rect:
+    /// four k x k corners, an edge profile repeated along each side and a flat
+    /// centre. Drawing is span blends only; no per-pixel shape maths.
+    struct NinePatch
+    {
+        QC::u32 extent = 0;             // Corner size k
+        QC::Vector<QC::u32> corners;    // 2k x 2k premultiplied; quadrants are the four corners
+        QC::Vector<QC::u32> edgeRow;    // 2k premultiplied: left edge outer->inner, then right edge inner->outer
+        QC::Vector<QC::u32> edgeColumn; // 2k straight alpha: top edge rows, then bottom edge rows
+        QC::u32 center = 0;             // Straight alpha
+
+        /// Blend the patch stretched over `rect` into a target (pitch in pixels).
+        /// `rect` must be at least 2k on each side; `clip` must lie inside the target.
+        void draw(QC::u32 *pixels, QC::usize pitch, const QC::Rect &rect, const QC::Rect &clip) const;
+    };
+
+    /// NinePatchCache - nine-patches keyed by shape parameters and colour.
+    /// Styles reuse a handful of (radius, blur, colour) combinations, so a small
+    /// LRU table keeps every one of them rendered.
+    class NinePatchCache
+    {
+    public:
+        /// Largest radius or blur rendered; callers clamp to this
+        static constexpr QC::u32 MaxExtent = 32;
+
+        static NinePatchCache &instance();
+
+        /// Anti-aliased rounded rect with an inner stroke; k = max(radius, strokeWidth)
+        const NinePatch *roundedRect(QC::u32 radius, QC::u32 strokeWidth, QC::Color fill, QC::Color stroke);
+
+        /// Box-blurred rect edge (three passes, close to a Gaussian with sigma blur/2);
+        /// draw over the shadow rect grown by `blur`, k = 2 * blur
+        const NinePatch *shadow(QC::u32 blur, QC::Color color);
+
+        /// Rounded-rect patch to draw over `rect`, radius and stroke clamped to fit it
+        /// @return nullptr if there is no corner to round; draw a plain rect instead
+        const NinePatch *roundedRectFor(const QC::Rect &rect, QC::u32 radius, QC::u32 strokeWidth,
+                                        QC::Color fill, QC::Color stroke);
+
+        /// Shadow patch for `shadowRect`, blur clamped to fit it; `patchRect` receives
+        /// the grown rect to draw the patch over
+        /// @return nullptr if there is no blur; fill `shadowRect` flat instead
+        const NinePatch *shadowFor(const QC::Rect &shadowRect, QC::i32 blurRadius, QC::Color color,
+                                   QC::Rect &patchRect);
+
+        void clear();
+
+    private:
+        NinePatchCache() = default;
+
+        enum class Kind : QC::u8
+        {
+            RoundedRect,
+            Shadow
+        };
+
+        struct Entry
+        {
+            bool used = false;
+            Kind kind = Kind::RoundedRect;
+            QC::u32 size = 0;
+            QC::u32 strokeWidth = 0;
+            QC::u32 color = 0;
+            QC::u32 strokeColor = 0;
+            QC::u64 lastUse = 0;
+            NinePatch patch;
+        };
+
+        static constexpr QC::usize MaxEntries = 16;
+
+        /// Matching entry, or the least recently used slot (marked unused) to render into
+        Entry &lookup(Kind kind, QC::u32 size, QC::u32 strokeWidth, QC::u32 color, QC::u32 strokeColor);
+
+        Entry m_entries[MaxEntries];
+        QC::u64 m_clock = 0;
+    };
+
+} // namespace QG
@@ -4,6 +4,7 @@
 // Namespace: QG
 
 #include "QGPainter.h"
+#include "QGPixelKernels.h"
 
 namespace QG
 {
@@ -67,12 +68,25 @@ namespace QG
                        const QC::u32 *pixels, QC::u32 width, QC::u32 height,
                        QC::u32 stride = 0) override;
 
+        void blitPremultiplied(QC::i32 x, QC::i32 y,
+                               const QC::u32 *pixels, QC::u32 width, QC::u32 height,
+                               QC::u32 stride = 0) override;
+
+        bool scrollRect(const QC::Rect &rect, QC::i32 dx, QC::i32 dy) override;
+
         void clear(QC::Color color) override;
 
     private:
         bool inClip(QC::i32 x, QC::i32 y) const;
+        /// Clip a surface-space rect to the surface and clip rect
+        bool clipSpanRect(QC::Rect &rect) const;
+        /// Clip once, then hand each source row to the kernel for `format`
+        void blitRows(QC::i32 x, QC::i32 y,
+                      const QC::u32 *pixels, QC::u32 width, QC::u32 height,
+                      QC::u32 stride, SurfaceFormat format);
         QC::i32 textPixelScale() const;
-        void stampGlyphPixel(QC::i32 baseX, QC::i32 baseY, QC::i32 scale, QC::Color color);
+        /// Fill one glyph's cached spans at surface position (x, y)
+        void drawGlyph(char c, QC::i32 x, QC::i32 y, QC::i32 scale, QC::Color color, const QC::Rect &clip);
 
         QC::u32 *m_pixels;
         QC::u32 m_width;
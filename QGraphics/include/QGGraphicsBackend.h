@@ -76,6 +76,9 @@ namespace QG
                           const QC::u32 *pixels,
                           QC::u32 stride,
                           bool useAlpha) = 0;
+        /// Move the target pixels inside `rect` by (dx, dy); the exposed strip
+        /// is left for the caller to redraw. Returns false if nothing moved.
+        virtual bool scrollRect(const QC::Rect &rect, QC::i32 dx, QC::i32 dy) = 0;
     };
 
 } // namespace QG
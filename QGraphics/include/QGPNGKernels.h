@@ -0,0 +1,56 @@
+#pragma once
+
+// QGraphics PNGKernels - SIMD scanline unfiltering and pixel conversion for PNG decode
+// Namespace: QG
+
+#include "QCTypes.h"
+#include "QGPixelKernels.h"
+
+namespace QG
+{
+
+    /// PNGKernels - per-scanline PNG reconstruction and RGBA/RGB/grey to ARGB
+    /// conversion, selected at runtime like PixelKernels (AVX2, SSSE3, SSE2,
+    /// scalar). Sub/Avg/Paeth depend on the previous pixel, so the vector
+    /// versions work one pixel per step for 3 and 4 byte pixels; other pixel
+    /// sizes use the scalar code.
+    class PNGKernels
+    {
+    public:
+        static PNGKernels &instance();
+
+        /// Re-run ISA selection (e.g. if first used before QArch::CPU::initialize)
+        void select();
+
+        PixelIsa isa() const { return m_isa; }
+
+        /// Reconstruct one scanline in place. `prev` is the reconstructed
+        /// previous line (all zero for the first line); `bpp` is bytes per pixel.
+        /// @return false for an unknown filter type
+        bool unfilter(QC::u8 filter, QC::u8 *row, const QC::u8 *prev, QC::usize length, QC::u32 bpp) const;
+
+        /// RGBA bytes -> straight-alpha ARGB pixels
+        void convertRGBA(QC::u32 *dst, const QC::u8 *src, QC::usize count) const { m_convertRGBA(dst, src, count); }
+        /// RGB bytes -> opaque ARGB pixels
+        void convertRGB(QC::u32 *dst, const QC::u8 *src, QC::usize count) const { m_convertRGB(dst, src, count); }
+        /// Grey bytes -> opaque ARGB pixels
+        void convertGray(QC::u32 *dst, const QC::u8 *src, QC::usize count) const { m_convertGray(dst, src, count); }
+
+    private:
+        PNGKernels();
+
+        using UpFn = void (*)(QC::u8 *, const QC::u8 *, QC::usize);
+        using FilterFn = void (*)(QC::u8 *, const QC::u8 *, QC::usize, QC::u32);
+        using ConvertFn = void (*)(QC::u32 *, const QC::u8 *, QC::usize);
+
+        UpFn m_up;
+        FilterFn m_sub;
+        FilterFn m_avg;
+        FilterFn m_paeth;
+        ConvertFn m_convertRGBA;
+        ConvertFn m_convertRGB;
+        ConvertFn m_convertGray;
+        PixelIsa m_isa;
+    };
+
+} // namespace QG
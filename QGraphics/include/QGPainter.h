@@ -192,6 +192,23 @@ namespace QG
                                const QC::u32 *pixels, QC::u32 width, QC::u32 height,
                                QC::u32 stride = 0) = 0;
 
+        /// Composite premultiplied-alpha pixels over the surface
+        virtual void blitPremultiplied(QC::i32 x, QC::i32 y,
+                                       const QC::u32 *pixels, QC::u32 width, QC::u32 height,
+                                       QC::u32 stride = 0) = 0;
+
+        /// Move the pixels inside `rect` by (dx, dy), clipped to the surface and
+        /// clip rect. The strip uncovered by the move keeps its old pixels and
+        /// must be repainted by the caller.
+        /// @return false if the painter cannot move pixels (repaint instead)
+        virtual bool scrollRect(const QC::Rect &rect, QC::i32 dx, QC::i32 dy)
+        {
+            (void)rect;
+            (void)dx;
+            (void)dy;
+            return false;
+        }
+
         // ==================== Clear ====================
 
         /// Clear entire surface with color
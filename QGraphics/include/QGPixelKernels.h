@@ -0,0 +1,105 @@
+#pragma once
+
+// QGraphics PixelKernels - SIMD span primitives for 32-bit ARGB pixels
+// Namespace: QG
+
+#include "QCTypes.h"
+#include "QCColor.h"
+#include "QCGeometry.h"
+
+namespace QG
+{
+
+    /// Instruction set the active kernels were built for
+    enum class PixelIsa : QC::u8
+    {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+
+    /// How the alpha channel of a 32-bit ARGB surface is to be interpreted
+    enum class SurfaceFormat : QC::u8
+    {
+        Straight,      // Colour channels independent of alpha (QC::Color::blend semantics)
+        Premultiplied, // Colour channels already scaled by alpha
+        Opaque         // Every pixel has alpha 255; blits are plain copies
+    };
+
+    /// PixelKernels - span fill/copy/blend routines selected at runtime from
+    /// QArch::CPU features (AVX2, then SSE2, then scalar).
+    /// Callers clip once and hand whole spans to the kernels; the kernels never
+    /// bounds-check individual pixels.
+    class PixelKernels
+    {
+    public:
+        static PixelKernels &instance();
+
+        /// Re-run ISA selection (e.g. if first used before QArch::CPU::initialize)
+        void select();
+
+        PixelIsa isa() const { return m_isa; }
+        const char *isaName() const;
+
+        /// dst[0..count) = value
+        void fill(QC::u32 *dst, QC::u32 value, QC::usize count) const { m_fill(dst, value, count); }
+
+        /// dst[0..count) = src[0..count) (spans must not overlap)
+        void copy(QC::u32 *dst, const QC::u32 *src, QC::usize count) const { m_copy(dst, src, count); }
+
+        /// dst = src over dst, straight alpha (same result as QC::Color::blend)
+        void blend(QC::u32 *dst, const QC::u32 *src, QC::usize count) const { m_blend(dst, src, count); }
+
+        /// dst = color over dst, straight alpha
+        void blendSolid(QC::u32 *dst, QC::u32 color, QC::usize count) const { m_blendSolid(dst, color, count); }
+
+        /// dst = src over dst, src premultiplied (one multiply per channel)
+        void blendPremultiplied(QC::u32 *dst, const QC::u32 *src, QC::usize count) const
+        {
+            m_blendPremultiplied(dst, src, count);
+        }
+
+        /// Horizontal gradient span: dst[i] = gradientColor(from, to, startStep + i, segments)
+        void gradient(QC::u32 *dst, QC::Color from, QC::Color to,
+                      QC::i32 startStep, QC::i32 segments, QC::usize count) const;
+
+        /// Fill a rect that is already clipped to the target (pitch in pixels)
+        void fillRect(QC::u32 *pixels, QC::usize pitch, const QC::Rect &rect, QC::u32 value) const;
+
+        /// Move the pixels of a clipped rect by (dx, dy) within that rect (pitch in
+        /// pixels). Source and destination may overlap; pixels shifted past the
+        /// rect are dropped and the exposed strip is left untouched.
+        void moveRect(QC::u32 *pixels, QC::usize pitch, const QC::Rect &rect, QC::i32 dx, QC::i32 dy) const;
+
+        /// 2x2 box filter: dst[i] = mean of row0/row1 pixels 2i and 2i+1, per channel.
+        /// Both source rows must hold at least 2 * count pixels.
+        void downsample2x(QC::u32 *dst, const QC::u32 *row0, const QC::u32 *row1, QC::usize count) const
+        {
+            m_downsample2x(dst, row0, row1, count);
+        }
+
+        /// Colour at `step` of `segments` between two colours (rounded per channel)
+        static QC::Color gradientColor(QC::Color from, QC::Color to, QC::i32 step, QC::i32 segments);
+
+        /// Convert straight-alpha pixels to premultiplied form in place
+        static void premultiply(QC::u32 *pixels, QC::usize count);
+
+    private:
+        PixelKernels();
+
+        using FillFn = void (*)(QC::u32 *, QC::u32, QC::usize);
+        using CopyFn = void (*)(QC::u32 *, const QC::u32 *, QC::usize);
+        using BlendFn = void (*)(QC::u32 *, const QC::u32 *, QC::usize);
+        using BlendSolidFn = void (*)(QC::u32 *, QC::u32, QC::usize);
+        using DownsampleFn = void (*)(QC::u32 *, const QC::u32 *, const QC::u32 *, QC::usize);
+
+        FillFn m_fill;
+        CopyFn m_copy;
+        BlendFn m_blend;
+        BlendSolidFn m_blendSolid;
+        BlendFn m_blendPremultiplied;
+        DownsampleFn m_downsample2x;
+        PixelIsa m_isa;
+    };
+
+} // namespace QG
@@ -4,6 +4,7 @@
 #include "QCLogger.h"
 #include "QCString.h"
 #include "QGPainter.h"
+#include "QGPNGKernels.h"
 #include "miniz_tinfl.h"
 
 namespace QG
@@ -12,6 +13,14 @@ namespace QG
     {
         constexpr const char *LOG_MODULE = "QGImage";
 
+        QC::u32 nextSerial()
+        {
+            static QC::u32 serial = 0;
+            if (++serial == 0)
+                ++serial;
+            return serial;
+        }
+
         inline QC::u32 readU32(const QC::u8 *ptr)
         {
             return (static_cast<QC::u32>(ptr[0]) << 24) |
@@ -20,19 +29,6 @@ namespace QG
                    static_cast<QC::u32>(ptr[3]);
         }
 
-        inline QC::u8 paeth(QC::u8 a, QC::u8 b, QC::u8 c)
-        {
-            int p = static_cast<int>(a) + static_cast<int>(b) - static_cast<int>(c);
-            int pa = p > static_cast<int>(a) ? p - static_cast<int>(a) : static_cast<int>(a) - p;
-            int pb = p > static_cast<int>(b) ? p - static_cast<int>(b) : static_cast<int>(b) - p;
-            int pc = p > static_cast<int>(c) ? p - static_cast<int>(c) : static_cast<int>(c) - p;
-            if (pa <= pb && pa <= pc)
-                return a;
-            if (pb <= pc)
-                return b;
-            return c;
-        }
-
         struct PNGHeader
         {
             QC::u32 width = 0;
@@ -86,6 +82,196 @@ namespace QG
             return true;
         }
 
+        constexpr QC::u32 kChunkIHDR = 0x49484452;
+        constexpr QC::u32 kChunkIDAT = 0x49444154;
+        constexpr QC::u32 kChunkIEND = 0x49454E44;
+
+        /// Hands out IDAT payloads one chunk at a time, without copying them.
+        struct IdatReader
+        {
+            const QC::u8 *png;
+            QC::usize size;
+            QC::usize offset;
+            const QC::u8 *data = nullptr;
+            QC::usize remaining = 0;
+
+            IdatReader(const QC::u8 *pngData, QC::usize pngSize, QC::usize firstIdat)
+                : png(pngData), size(pngSize), offset(firstIdat)
+            {
+            }
+
+            /// Advance to the next non-empty IDAT; false at IEND or end of data
+            bool next()
+            {
+                while (offset < size)
+                {
+                    QC::u32 length = 0;
+                    QC::u32 type = 0;
+                    const QC::u8 *chunk = nullptr;
+                    if (!loadChunk(png, size, offset, length, type, chunk))
+                        return false;
+                    if (type == kChunkIEND)
+                        return false;
+                    if (type == kChunkIDAT && length > 0)
+                    {
+                        data = chunk;
+                        remaining = length;
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            void consume(QC::usize bytes)
+            {
+                data += bytes;
+                remaining -= bytes;
+            }
+        };
+
+        /// Streams inflated bytes through a dictionary-sized ring and turns each
+        /// scanline into output pixels as soon as its last byte arrives, so only
+        /// the ring and two scanlines exist besides the image itself.
+        class ScanlineDecoder
+        {
+        public:
+            ScanlineDecoder(const PNGHeader &header, QC::u32 bytesPerPixel)
+                : m_header(header),
+                  m_bpp(bytesPerPixel),
+                  m_stride(static_cast<QC::usize>(header.width) * bytesPerPixel),
+                  m_inflater(nullptr),
+                  m_ringPos(0),
+                  m_filled(0),
+                  m_row(0),
+                  m_out(nullptr)
+            {
+            }
+
+            ~ScanlineDecoder()
+            {
+                delete m_inflater;
+            }
+
+            ScanlineDecoder(const ScanlineDecoder &) = delete;
+            ScanlineDecoder &operator=(const ScanlineDecoder &) = delete;
+
+            bool begin(ImageSurface &out)
+            {
+                m_inflater = new tinfl_decompressor;
+                if (!m_inflater)
+                    return false;
+                tinfl_init(m_inflater);
+
+                m_ring.resize(TINFL_LZ_DICT_SIZE);
+                // Filter byte + scanline, twice: the row being filled and the previous
+                // reconstructed row (all zero before the first).
+                m_lines.resize(2 * (m_stride + 1));
+                m_cur = m_lines.data();
+                m_prev = m_lines.data() + m_stride + 1;
+
+                out.width = m_header.width;
+                out.height = m_header.height;
+                out.pixels.clear();
+                out.pixels.resize(static_cast<QC::usize>(m_header.width) * m_header.height);
+                m_out = &out;
+                return m_ring.size() == TINFL_LZ_DICT_SIZE && !out.pixels.empty();
+            }
+
+            /// Inflate into the free part of the ring; `produced`/`outBytes` describe the new bytes
+            tinfl_status inflate(const QC::u8 *in, size_t &inBytes, QC::u32 flags,
+                                 QC::u8 *&produced, size_t &outBytes)
+            {
+                produced = m_ring.data() + m_ringPos;
+                outBytes = TINFL_LZ_DICT_SIZE - m_ringPos;
+                const tinfl_status status = tinfl_decompress(m_inflater, in, &inBytes,
+                                                             m_ring.data(), produced, &outBytes, flags);
+                m_ringPos = (m_ringPos + outBytes) & (TINFL_LZ_DICT_SIZE - 1);
+                return status;
+            }
+
+            /// Append inflated bytes to the current scanline, finishing rows as they fill
+            bool consume(const QC::u8 *bytes, QC::usize count)
+            {
+                const QC::usize lineBytes = m_stride + 1;
+                while (count > 0)
+                {
+                    if (m_row >= m_header.height)
+                    {
+                        QC_LOG_WARN(LOG_MODULE, "PNG image data longer than the image");
+                        return false;
+                    }
+
+                    QC::usize take = lineBytes - m_filled;
+                    if (take > count)
+                        take = count;
+                    QC::String::memcpy(m_cur + m_filled, bytes, take);
+                    m_filled += take;
+                    bytes += take;
+                    count -= take;
+
+                    if (m_filled == lineBytes && !finishRow())
+                        return false;
+                }
+                return true;
+            }
+
+            bool complete() const { return m_row == m_header.height; }
+            QC::u32 rowsDone() const { return m_row; }
+
+        private:
+            bool finishRow()
+            {
+                const PNGKernels &kernels = PNGKernels::instance();
+                const QC::u8 filter = m_cur[0];
+                if (!kernels.unfilter(filter, m_cur + 1, m_prev + 1, m_stride, m_bpp))
+                {
+                    QC_LOG_WARN(LOG_MODULE, "Unsupported PNG filter type %u", filter);
+                    return false;
+                }
+
+                QC::u32 *dst = m_out->pixels.data() + static_cast<QC::usize>(m_row) * m_header.width;
+                switch (static_cast<PNGColorType>(m_header.colorType))
+                {
+                case PNGColorType::Grayscale:
+                    kernels.convertGray(dst, m_cur + 1, m_header.width);
+                    break;
+                case PNGColorType::RGB:
+                    kernels.convertRGB(dst, m_cur + 1, m_header.width);
+                    break;
+                case PNGColorType::RGBA:
+                    // Premultiply while the row is still in cache.
+                    kernels.convertRGBA(dst, m_cur + 1, m_header.width);
+                    PixelKernels::premultiply(dst, m_header.width);
+                    break;
+                default:
+                    return false;
+                }
+
+                QC::u8 *done = m_cur;
+                m_cur = m_prev;
+                m_prev = done;
+                m_filled = 0;
+                ++m_row;
+                return true;
+            }
+
+            const PNGHeader &m_header;
+            QC::u32 m_bpp;
+            QC::usize m_stride;
+
+            tinfl_decompressor *m_inflater;
+            QC::Vector<QC::u8> m_ring;
+            QC::usize m_ringPos;
+
+            QC::Vector<QC::u8> m_lines;
+            QC::u8 *m_cur = nullptr;
+            QC::u8 *m_prev = nullptr;
+            QC::usize m_filled;
+            QC::u32 m_row;
+
+            ImageSurface *m_out;
+        };
+
         bool decodePNGInternal(const QC::u8 *data, QC::usize size, ImageSurface &out)
         {
             out.reset();
@@ -101,11 +287,14 @@ namespace QG
 
             PNGHeader header;
             bool headerSeen = false;
-            QC::Vector<QC::u8> compressed;
+            QC::usize idatOffset = 0;
 
+            // Read ahead to the first IDAT; the image data is then inflated
+            // straight out of the chunks where they lie.
             QC::usize offset = 8;
-            while (offset < size)
+            while (offset < size && idatOffset == 0)
             {
+                const QC::usize chunkStart = offset;
                 QC::u32 chunkLength = 0;
                 QC::u32 chunkType = 0;
                 const QC::u8 *chunkPtr = nullptr;
@@ -114,22 +303,17 @@ namespace QG
 
                 switch (chunkType)
                 {
-                case 0x49484452: // IHDR
+                case kChunkIHDR:
                     if (!parseIHDR(chunkPtr, chunkLength, header))
                         return false;
                     headerSeen = true;
                     break;
-                case 0x49444154: // IDAT
+                case kChunkIDAT:
                     if (!headerSeen)
                         return false;
-                    if (chunkLength > 0)
-                    {
-                        const QC::usize oldSize = compressed.size();
-                        compressed.resize(oldSize + chunkLength);
-                        QC::String::memcpy(compressed.data() + oldSize, chunkPtr, chunkLength);
-                    }
+                    idatOffset = chunkStart;
                     break;
-                case 0x49454E44:   // IEND
+                case kChunkIEND:
                     offset = size; // Exit loop
                     break;
                 default:
@@ -137,7 +321,7 @@ namespace QG
                 }
             }
 
-            if (!headerSeen || compressed.empty())
+            if (!headerSeen || idatOffset == 0)
                 return false;
 
             if (header.bitDepth != 8)
@@ -169,101 +353,98 @@ namespace QG
                 return false;
             }
 
-            QC::usize stride = static_cast<QC::usize>(header.width) * bytesPerPixel;
-            QC::usize expectedSize = (stride + 1) * header.height;
-            if (expectedSize == 0)
+            if (header.width == 0 || header.height == 0)
+                return false;
+
+            ScanlineDecoder decoder(header, bytesPerPixel);
+            if (!decoder.begin(out))
+                return false;
+
+            IdatReader reader(data, size, idatOffset);
+            if (!reader.next())
                 return false;
 
-            QC::Vector<QC::u8> decompressed;
-            decompressed.resize(expectedSize);
-            size_t actualSize = expectedSize;
-            const int flags = TINFL_FLAG_PARSE_ZLIB_HEADER;
-            size_t result = tinfl_decompress_mem_to_mem(decompressed.data(), actualSize, compressed.data(), compressed.size(), flags);
-            if (result != TINFL_DECOMPRESS_MEM_TO_MEM_FAILED)
+            QC::u32 flags = TINFL_FLAG_PARSE_ZLIB_HEADER | TINFL_FLAG_HAS_MORE_INPUT;
+            for (;;)
             {
-                actualSize = result;
+                if (reader.remaining == 0 && (flags & TINFL_FLAG_HAS_MORE_INPUT) && !reader.next())
+                    flags &= ~static_cast<QC::u32>(TINFL_FLAG_HAS_MORE_INPUT);
+
+                size_t inBytes = reader.remaining;
+                size_t outBytes = 0;
+                QC::u8 *produced = nullptr;
+                const tinfl_status status = decoder.inflate(reader.data, inBytes, flags, produced, outBytes);
+                reader.consume(inBytes);
+
+                if (!decoder.consume(produced, outBytes))
+                    return false;
+
+                if (status == TINFL_STATUS_DONE)
+                    break;
+                if (status < TINFL_STATUS_DONE)
+                {
+                    QC_LOG_WARN(LOG_MODULE, "PNG zlib inflate failed (status %d)", static_cast<int>(status));
+                    return false;
+                }
             }
-            if (result == TINFL_DECOMPRESS_MEM_TO_MEM_FAILED || actualSize != expectedSize)
+
+            if (!decoder.complete())
             {
-                QC_LOG_WARN(LOG_MODULE, "PNG zlib inflate failed (expected %zu, got %zu)", static_cast<size_t>(expectedSize), actualSize);
+                QC_LOG_WARN(LOG_MODULE, "PNG image data ended early (%u of %u rows)", decoder.rowsDone(), header.height);
                 return false;
             }
 
-            QC::Vector<QC::u8> reconPrev;
-            QC::Vector<QC::u8> reconCur;
-            reconPrev.resize(stride);
-            reconCur.resize(stride);
+            // Rows were premultiplied as they were decoded, so every later blit
+            // is a copy or a premultiplied blend.
+            if (static_cast<PNGColorType>(header.colorType) == PNGColorType::RGBA)
+            {
+                out.format = SurfaceFormat::Premultiplied;
+            }
+            else
+            {
+                out.format = SurfaceFormat::Opaque;
+            }
+            out.analyzeCoverage();
+            out.buildMips();
+            out.serial = nextSerial();
 
-            out.width = header.width;
-            out.height = header.height;
-            out.pixels.clear();
-            out.pixels.resize(static_cast<QC::usize>(header.width) * header.height);
+            return out.isValid();
+        }
 
-            const QC::u8 *src = decompressed.data();
-            for (QC::u32 y = 0; y < header.height; ++y)
+        /// Draw `rows` source rows starting at `firstRow`, batching runs of equal
+        /// coverage into one painter call.
+        void blitSurfaceRows(IPainter *painter,
+                             const ImageSurface &surface,
+                             QC::i32 x,
+                             QC::i32 y,
+                             QC::u32 firstRow,
+                             QC::u32 rows)
+        {
+            const QC::u32 *source = surface.data();
+            QC::u32 row = 0;
+            while (row < rows)
             {
-                QC::u8 filterType = *src++;
-                for (QC::usize x = 0; x < stride; ++x)
+                const RowCoverage coverage = surface.coverage(firstRow + row);
+                QC::u32 run = 1;
+                while (row + run < rows && surface.coverage(firstRow + row + run) == coverage)
+                    ++run;
+
+                const QC::u32 *pixels = source + static_cast<QC::usize>(firstRow + row) * surface.width;
+                const QC::i32 runY = y + static_cast<QC::i32>(row);
+                if (coverage == RowCoverage::Opaque)
                 {
-                    QC::u8 raw = *src++;
-                    QC::u8 left = (x >= bytesPerPixel) ? reconCur[x - bytesPerPixel] : 0;
-                    QC::u8 up = (y > 0) ? reconPrev[x] : 0;
-                    QC::u8 upLeft = (y > 0 && x >= bytesPerPixel) ? reconPrev[x - bytesPerPixel] : 0;
-
-                    switch (filterType)
-                    {
-                    case 0:
-                        reconCur[x] = raw;
-                        break;
-                    case 1:
-                        reconCur[x] = static_cast<QC::u8>(raw + left);
-                        break;
-                    case 2:
-                        reconCur[x] = static_cast<QC::u8>(raw + up);
-                        break;
-                    case 3:
-                        reconCur[x] = static_cast<QC::u8>(raw + static_cast<QC::u8>((static_cast<int>(left) + static_cast<int>(up)) / 2));
-                        break;
-                    case 4:
-                        reconCur[x] = static_cast<QC::u8>(raw + paeth(left, up, upLeft));
-                        break;
-                    default:
-                        QC_LOG_WARN(LOG_MODULE, "Unsupported PNG filter type %u", filterType);
-                        return false;
-                    }
+                    painter->blit(x, runY, pixels, surface.width, run, surface.width);
                 }
-
-                const QC::u8 *row = reconCur.data();
-                for (QC::u32 x = 0; x < header.width; ++x)
+                else if (coverage == RowCoverage::Mixed)
                 {
-                    QC::u8 r = 0, g = 0, b = 0, a = 255;
-                    switch (static_cast<PNGColorType>(header.colorType))
-                    {
-                    case PNGColorType::Grayscale:
-                        r = g = b = row[x];
-                        break;
-                    case PNGColorType::RGB:
-                        r = row[x * 3 + 0];
-                        g = row[x * 3 + 1];
-                        b = row[x * 3 + 2];
-                        break;
-                    case PNGColorType::RGBA:
-                        r = row[x * 4 + 0];
-                        g = row[x * 4 + 1];
-                        b = row[x * 4 + 2];
-                        a = row[x * 4 + 3];
-                        break;
-                    default:
-                        break;
-                    }
-
-                    out.pixels[y * header.width + x] = QC::Color(r, g, b, a).value;
+                    if (surface.format == SurfaceFormat::Premultiplied)
+                        painter->blitPremultiplied(x, runY, pixels, surface.width, run, surface.width);
+                    else
+                        painter->blitAlpha(x, runY, pixels, surface.width, run, surface.width);
                 }
 
-                reconPrev = reconCur;
+                row += run;
             }
-
-            return out.isValid();
         }
 
         QC::Rect computeTargetRect(const QC::Rect &dest,
@@ -329,52 +510,105 @@ namespace QG
             return result;
         }
 
-        void blitScaledNearest(IPainter *painter,
-                               const ImageSurface &surface,
-                               const QC::Rect &target,
-                               QC::Vector<QC::u32> &scratch)
+        /// Pixels of the mip level (0 = the image itself)
+        struct LevelView
         {
-            if (!painter)
-                return;
+            const QC::u32 *pixels;
+            QC::u32 width;
+            QC::u32 height;
+        };
 
-            if (target.width == surface.width && target.height == surface.height)
+        /// Smallest level still at least as large as the target, so bilinear
+        /// sampling never skips more than one source pixel in each direction.
+        LevelView pickLevel(const ImageSurface &surface, QC::u32 targetWidth, QC::u32 targetHeight)
+        {
+            LevelView view = {surface.data(), surface.width, surface.height};
+            for (QC::usize i = 0; i < surface.mips.size(); ++i)
             {
-                painter->blitAlpha(target.x,
-                                   target.y,
-                                   surface.data(),
-                                   surface.width,
-                                   surface.height,
-                                   surface.width);
-                return;
+                const MipLevel &mip = surface.mips[i];
+                if (mip.width < targetWidth || mip.height < targetHeight)
+                    break;
+                view = {mip.pixels.data(), mip.width, mip.height};
             }
+            return view;
+        }
 
-            scratch.resize(target.width);
-            const QC::u32 *source = surface.data();
+        /// a + (b - a) * weight / 256, per channel; weight in [0, 256]
+        inline QC::u32 lerpPixel(QC::u32 a, QC::u32 b, QC::u32 weight)
+        {
+            const QC::u32 inverse = 256 - weight;
+            const QC::u32 rb = (((a & 0x00FF00FFu) * inverse + (b & 0x00FF00FFu) * weight) >> 8) & 0x00FF00FFu;
+            const QC::u32 ag = (((a >> 8) & 0x00FF00FFu) * inverse + ((b >> 8) & 0x00FF00FFu) * weight) & 0xFF00FF00u;
+            return rb | ag;
+        }
 
-            for (QC::u32 y = 0; y < target.height; ++y)
+        /// Sample positions along one axis: pixel centres mapped into the source
+        /// in 16.16 fixed point, split into a left index and an 8-bit weight.
+        void buildAxis(QC::u32 sourceSize, QC::u32 targetSize, QC::Vector<QC::u32> &index, QC::Vector<QC::u32> &weight)
+        {
+            index.resize(targetSize);
+            weight.resize(targetSize);
+            const QC::i64 step = (static_cast<QC::i64>(sourceSize) << 16) / targetSize;
+            QC::i64 position = step / 2 - 0x8000;
+            const QC::i64 last = static_cast<QC::i64>(sourceSize - 1) << 16;
+            for (QC::u32 i = 0; i < targetSize; ++i, position += step)
             {
-                QC::u32 srcY = (static_cast<QC::u64>(y) * surface.height) / target.height;
-                const QC::u32 *srcRow = source + srcY * surface.width;
-                for (QC::u32 x = 0; x < target.width; ++x)
+                QC::i64 p = position < 0 ? 0 : (position > last ? last : position);
+                index[i] = static_cast<QC::u32>(p >> 16);
+                weight[i] = static_cast<QC::u32>((p & 0xFFFF) >> 8);
+                if (index[i] + 1 >= sourceSize)
+                    weight[i] = 0;
+            }
+        }
+
+        /// Bilinear resample from the nearest mip level into `out`
+        void scaleBilinear(const ImageSurface &surface, QC::u32 targetWidth, QC::u32 targetHeight, ImageSurface &out)
+        {
+            const LevelView level = pickLevel(surface, targetWidth, targetHeight);
+
+            QC::Vector<QC::u32> xIndex;
+            QC::Vector<QC::u32> xWeight;
+            QC::Vector<QC::u32> yIndex;
+            QC::Vector<QC::u32> yWeight;
+            buildAxis(level.width, targetWidth, xIndex, xWeight);
+            buildAxis(level.height, targetHeight, yIndex, yWeight);
+
+            out.reset();
+            out.width = targetWidth;
+            out.height = targetHeight;
+            out.format = surface.format;
+            out.pixels.resize(static_cast<QC::usize>(targetWidth) * targetHeight);
+
+            QC::u32 *dst = out.pixels.data();
+            for (QC::u32 y = 0; y < targetHeight; ++y, dst += targetWidth)
+            {
+                const QC::u32 *row0 = level.pixels + static_cast<QC::usize>(yIndex[y]) * level.width;
+                const QC::u32 *row1 = yWeight[y] ? row0 + level.width : row0;
+                const QC::u32 wy = yWeight[y];
+                for (QC::u32 x = 0; x < targetWidth; ++x)
                 {
-                    QC::u32 srcX = (static_cast<QC::u64>(x) * surface.width) / target.width;
-                    scratch[x] = srcRow[srcX];
+                    const QC::u32 sx = xIndex[x];
+                    const QC::u32 wx = xWeight[x];
+                    const QC::u32 sx1 = wx ? sx + 1 : sx;
+                    const QC::u32 top = lerpPixel(row0[sx], row0[sx1], wx);
+                    const QC::u32 bottom = lerpPixel(row1[sx], row1[sx1], wx);
+                    dst[x] = lerpPixel(top, bottom, wy);
                 }
-                painter->blitAlpha(target.x,
-                                   target.y + static_cast<QC::i32>(y),
-                                   scratch.data(),
-                                   target.width,
-                                   1,
-                                   target.width);
             }
+
+            out.analyzeCoverage();
         }
     } // namespace
 
     void ImageSurface::reset()
     {
         pixels.clear();
+        rowCoverage.clear();
+        mips.clear();
+        format = SurfaceFormat::Straight;
         width = 0;
         height = 0;
+        serial = 0;
     }
 
     bool ImageSurface::isValid() const
@@ -387,6 +621,107 @@ namespace QG
         return pixels.empty() ? nullptr : pixels.data();
     }
 
+    void ImageSurface::analyzeCoverage()
+    {
+        rowCoverage.clear();
+        if (!isValid())
+            return;
+
+        rowCoverage.resize(height);
+        bool allOpaque = true;
+        const QC::u32 *row = pixels.data();
+        for (QC::u32 y = 0; y < height; ++y, row += width)
+        {
+            QC::u32 andAll = 0xFFFFFFFFu;
+            QC::u32 orAll = 0;
+            for (QC::u32 x = 0; x < width; ++x)
+            {
+                andAll &= row[x];
+                orAll |= row[x];
+            }
+
+            // A premultiplied pixel with alpha 0 but non-zero colour is
+            // additive, so such rows only count as transparent when all zero.
+            const bool noAlpha = (orAll >> 24) == 0;
+            if ((andAll >> 24) == 0xFF)
+                rowCoverage[y] = RowCoverage::Opaque;
+            else if (noAlpha && (format != SurfaceFormat::Premultiplied || orAll == 0))
+                rowCoverage[y] = RowCoverage::Transparent;
+            else
+                rowCoverage[y] = RowCoverage::Mixed;
+
+            allOpaque = allOpaque && rowCoverage[y] == RowCoverage::Opaque;
+        }
+
+        if (allOpaque)
+            format = SurfaceFormat::Opaque;
+    }
+
+    void ImageSurface::buildMips()
+    {
+        mips.clear();
+        if (!isValid())
+            return;
+
+        const PixelKernels &kernels = PixelKernels::instance();
+        const QC::u32 *source = pixels.data();
+        QC::u32 sourceWidth = width;
+        QC::u32 sourceHeight = height;
+        while (sourceWidth > 1 || sourceHeight > 1)
+        {
+            MipLevel level;
+            level.width = sourceWidth > 1 ? sourceWidth / 2 : 1;
+            level.height = sourceHeight > 1 ? sourceHeight / 2 : 1;
+            level.pixels.resize(static_cast<QC::usize>(level.width) * level.height);
+
+            // An odd last column or row is folded away; a single column is
+            // paired with itself.
+            QC::u32 pair0[2];
+            QC::u32 pair1[2];
+            for (QC::u32 y = 0; y < level.height; ++y)
+            {
+                const QC::u32 y0 = sourceHeight > 1 ? 2 * y : 0;
+                const QC::u32 *row0 = source + static_cast<QC::usize>(y0) * sourceWidth;
+                const QC::u32 *row1 = sourceHeight > 1 ? row0 + sourceWidth : row0;
+                QC::u32 *dst = level.pixels.data() + static_cast<QC::usize>(y) * level.width;
+                if (sourceWidth > 1)
+                {
+                    kernels.downsample2x(dst, row0, row1, level.width);
+                }
+                else
+                {
+                    pair0[0] = pair0[1] = row0[0];
+                    pair1[0] = pair1[1] = row1[0];
+                    kernels.downsample2x(dst, pair0, pair1, 1);
+                }
+            }
+
+            mips.push_back(static_cast<MipLevel &&>(level));
+            const MipLevel &added = mips.back();
+            source = added.pixels.data();
+            sourceWidth = added.width;
+            sourceHeight = added.height;
+        }
+    }
+
+    void ScaledImage::reset()
+    {
+        surface.reset();
+        serial = 0;
+        width = 0;
+        height = 0;
+        mode = ImageScaleMode::Original;
+    }
+
+    RowCoverage ImageSurface::coverage(QC::u32 row) const
+    {
+        if (format == SurfaceFormat::Opaque)
+            return RowCoverage::Opaque;
+        if (row >= rowCoverage.size())
+            return RowCoverage::Mixed;
+        return rowCoverage[row];
+    }
+
     bool decodePNG(const QC::u8 *data, QC::usize size, ImageSurface &outSurface)
     {
         return decodePNGInternal(data, size, outSurface);
@@ -403,7 +738,7 @@ namespace QG
                    const ImageSurface &surface,
                    const QC::Rect &destination,
                    ImageScaleMode scaleMode,
-                   QC::Vector<QC::u32> &scratchRow)
+                   ScaledImage &cache)
     {
         if (!painter || !surface.isValid() || destination.width == 0 || destination.height == 0)
             return;
@@ -417,12 +752,7 @@ namespace QG
             {
                 for (QC::i32 x = 0; x < destination.width; x += static_cast<QC::i32>(surface.width))
                 {
-                    painter->blitAlpha(destination.x + x,
-                                       destination.y + y,
-                                       surface.data(),
-                                       surface.width,
-                                       surface.height,
-                                       surface.width);
+                    blitSurfaceRows(painter, surface, destination.x + x, destination.y + y, 0, surface.height);
                 }
             }
             return;
@@ -432,7 +762,23 @@ namespace QG
         if (target.width == 0 || target.height == 0)
             return;
 
-        blitScaledNearest(painter, surface, target, scratchRow);
+        if (target.width == surface.width && target.height == surface.height)
+        {
+            blitSurfaceRows(painter, surface, target.x, target.y, 0, surface.height);
+            return;
+        }
+
+        if (surface.serial == 0 || cache.serial != surface.serial || cache.width != target.width ||
+            cache.height != target.height || cache.mode != scaleMode)
+        {
+            scaleBilinear(surface, target.width, target.height, cache.surface);
+            cache.serial = surface.serial;
+            cache.width = target.width;
+            cache.height = target.height;
+            cache.mode = scaleMode;
+        }
+
+        blitSurfaceRows(painter, cache.surface, target.x, target.y, 0, cache.surface.height);
     }
 
 } // namespace QG
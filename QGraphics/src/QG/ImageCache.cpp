@@ -0,0 +1,239 @@
+// QGraphics ImageCache - Decoded image assets shared across themes
+// Namespace: QG
+
+#include "QG/ImageCache.h"
+#include "QCLogger.h"
+#include "QCString.h"
+
+namespace QG
+{
+
+    namespace
+    {
+        constexpr const char *LOG_MODULE = "QGImageCache";
+
+        constexpr QC::u64 kFnvOffset = 0xCBF29CE484222325ull;
+        constexpr QC::u64 kFnvPrime = 0x100000001B3ull;
+
+        inline QC::usize surfaceBytes(const ImageSurface &surface)
+        {
+            QC::usize bytes = surface.pixels.size() * sizeof(QC::u32) + surface.rowCoverage.size() * sizeof(RowCoverage);
+            for (QC::usize i = 0; i < surface.mips.size(); ++i)
+                bytes += surface.mips[i].pixels.size() * sizeof(QC::u32);
+            return bytes;
+        }
+    } // namespace
+
+    ImageCache &ImageCache::instance()
+    {
+        static ImageCache cache;
+        return cache;
+    }
+
+    ImageCache::ImageCache()
+    {
+        for (QC::usize i = 0; i < BucketCount; ++i)
+            m_buckets[i] = nullptr;
+    }
+
+    QC::u64 ImageCache::hashPath(const char *path)
+    {
+        // FNV-1a
+        QC::u64 hash = kFnvOffset;
+        for (const char *p = path; p && *p; ++p)
+        {
+            hash ^= static_cast<QC::u8>(*p);
+            hash *= kFnvPrime;
+        }
+        return hash;
+    }
+
+    ImageCache::Entry *ImageCache::find(QC::u64 hash, const char *path) const
+    {
+        for (Entry *entry = m_buckets[hash % BucketCount]; entry; entry = entry->nextInBucket)
+        {
+            if (entry->hash == hash && QC::String::strcmp(entry->path, path) == 0)
+                return entry;
+        }
+        return nullptr;
+    }
+
+    void ImageCache::link(Entry *entry)
+    {
+        Entry *&head = m_buckets[entry->hash % BucketCount];
+        entry->nextInBucket = head;
+        head = entry;
+        entry->linked = true;
+    }
+
+    void ImageCache::unlink(Entry *entry)
+    {
+        if (!entry->linked)
+            return;
+
+        Entry **slot = &m_buckets[entry->hash % BucketCount];
+        while (*slot && *slot != entry)
+            slot = &(*slot)->nextInBucket;
+        if (*slot)
+            *slot = entry->nextInBucket;
+        entry->nextInBucket = nullptr;
+        entry->linked = false;
+    }
+
+    void ImageCache::destroy(Entry *entry)
+    {
+        unlink(entry);
+        for (QC::usize i = 0; i < m_entries.size(); ++i)
+        {
+            if (m_entries[i] == entry)
+            {
+                m_entries[i] = m_entries.back();
+                m_entries.pop_back();
+                break;
+            }
+        }
+        m_cachedBytes -= entry->bytes;
+        delete entry;
+    }
+
+    const ImageSurface *ImageCache::acquire(const char *path, QC::u64 stamp)
+    {
+        if (!path || !*path)
+            return nullptr;
+
+        Entry *entry = find(hashPath(path), path);
+        if (!entry)
+        {
+            ++m_misses;
+            return nullptr;
+        }
+
+        if (entry->stamp != stamp)
+        {
+            // The file changed. A pinned copy stays alive for whoever still
+            // draws it, but is no longer found; it goes when its last pin does.
+            ++m_misses;
+            if (entry->pins == 0)
+                destroy(entry);
+            else
+                unlink(entry);
+            return nullptr;
+        }
+
+        ++m_hits;
+        ++entry->pins;
+        entry->lastUse = ++m_clock;
+        return &entry->surface;
+    }
+
+    const ImageSurface *ImageCache::insert(const char *path, QC::u64 stamp, const QC::u8 *data, QC::usize size)
+    {
+        if (!path || !*path || !data || size == 0)
+            return nullptr;
+
+        if (QC::String::strlen(path) >= MaxPathLength)
+        {
+            QC_LOG_WARN(LOG_MODULE, "Image path too long to cache: %s", path);
+            return nullptr;
+        }
+
+        const QC::u64 hash = hashPath(path);
+        if (Entry *existing = find(hash, path))
+        {
+            if (existing->stamp == stamp)
+            {
+                ++existing->pins;
+                existing->lastUse = ++m_clock;
+                return &existing->surface;
+            }
+            if (existing->pins == 0)
+                destroy(existing);
+            else
+                unlink(existing);
+        }
+
+        auto *entry = new Entry();
+        if (!entry)
+            return nullptr;
+
+        if (!decodePNG(data, size, entry->surface))
+        {
+            delete entry;
+            return nullptr;
+        }
+
+        entry->hash = hash;
+        entry->stamp = stamp;
+        QC::String::strncpy(entry->path, path, MaxPathLength - 1);
+        entry->path[MaxPathLength - 1] = '\0';
+        entry->bytes = surfaceBytes(entry->surface);
+        entry->pins = 1;
+        entry->lastUse = ++m_clock;
+
+        link(entry);
+        m_entries.push_back(entry);
+        m_cachedBytes += entry->bytes;
+
+        enforceBudget();
+        return &entry->surface;
+    }
+
+    void ImageCache::release(const ImageSurface *surface)
+    {
+        if (!surface)
+            return;
+
+        for (QC::usize i = 0; i < m_entries.size(); ++i)
+        {
+            Entry *entry = m_entries[i];
+            if (&entry->surface != surface)
+                continue;
+
+            if (entry->pins > 0)
+                --entry->pins;
+            if (entry->pins == 0)
+            {
+                if (!entry->linked)
+                    destroy(entry);
+                else
+                    enforceBudget();
+            }
+            return;
+        }
+    }
+
+    QC::usize ImageCache::trim(QC::usize keepBytes)
+    {
+        QC::usize freed = 0;
+        while (m_cachedBytes > keepBytes)
+        {
+            Entry *victim = nullptr;
+            for (QC::usize i = 0; i < m_entries.size(); ++i)
+            {
+                Entry *entry = m_entries[i];
+                if (entry->pins == 0 && (!victim || entry->lastUse < victim->lastUse))
+                    victim = entry;
+            }
+            if (!victim)
+                break; // Everything left is on screen
+
+            freed += victim->bytes;
+            destroy(victim);
+        }
+        return freed;
+    }
+
+    void ImageCache::enforceBudget()
+    {
+        // Pinned images may push the total over budget; they are never evicted.
+        if (m_cachedBytes > m_budgetBytes)
+            trim(m_budgetBytes);
+    }
+
+    void ImageCache::setBudget(QC::usize bytes)
+    {
+        m_budgetBytes = bytes;
+        enforceBudget();
+    }
+
+} // namespace QG
@@ -0,0 +1,363 @@
+// QGraphics NinePatch - Pre-rendered rounded rects and blurred shadows
+// Namespace: QG
+
+#include "QG/NinePatch.h"
+#include "QGPixelKernels.h"
+
+namespace QG
+{
+
+    namespace
+    {
+        // Rounded-rect coverage is sampled on a 4x4 grid; positions are in 1/8 pixel
+        // so every sample centre is an integer.
+        constexpr QC::i32 kSubsamples = 4;
+        constexpr QC::i32 kSubUnit = 8;
+
+        // A corner or blur may take at most half the rect (so the patch can
+        // stretch) and never more than the cache renders.
+        inline QC::u32 fitExtent(QC::u32 value, const QC::Rect &rect)
+        {
+            QC::u32 limit = (rect.width < rect.height ? rect.width : rect.height) / 2;
+            if (limit > NinePatchCache::MaxExtent)
+                limit = NinePatchCache::MaxExtent;
+            return value < limit ? value : limit;
+        }
+
+        inline QC::u32 div255(QC::u32 x)
+        {
+            return (x + 1 + (x >> 8)) >> 8;
+        }
+
+        inline QC::u32 premultiplied(QC::Color c)
+        {
+            return (static_cast<QC::u32>(c.a) << 24) |
+                   (div255(c.r * c.a) << 16) |
+                   (div255(c.g * c.a) << 8) |
+                   div255(c.b * c.a);
+        }
+
+        // Weighted sum of two premultiplied colours; weights are out of `total`.
+        inline QC::u32 mixPremultiplied(QC::u32 a, QC::u32 wa, QC::u32 b, QC::u32 wb, QC::u32 total)
+        {
+            QC::u32 out = 0;
+            for (QC::u32 shift = 0; shift < 32; shift += 8)
+            {
+                const QC::u32 c = (((a >> shift) & 0xFF) * wa + ((b >> shift) & 0xFF) * wb + total / 2) / total;
+                out |= (c > 255 ? 255 : c) << shift;
+            }
+            return out;
+        }
+
+        // Is sample (x, y) inside a rounded rect whose top-left corner is inset by
+        // `inset`, with corner radius `radius`? All values in sub-pixel units; only
+        // the top-left corner is tested, the patch mirrors it.
+        inline bool insideCorner(QC::i32 x, QC::i32 y, QC::i32 inset, QC::i32 radius)
+        {
+            if (x < inset || y < inset)
+                return false;
+
+            const QC::i32 c = inset + radius;
+            if (x >= c || y >= c)
+                return true;
+
+            const QC::i64 dx = c - x;
+            const QC::i64 dy = c - y;
+            return dx * dx + dy * dy <= static_cast<QC::i64>(radius) * radius;
+        }
+
+        // Coverage (0..255) across a blurred rect edge that sits `blur` pixels into
+        // a 2 * blur profile. Three box passes of width ~blur approximate a Gaussian
+        // with sigma blur / 2; the tail past the patch is under 3%.
+        void blurredEdgeProfile(QC::u32 blur, QC::u32 *out)
+        {
+            const QC::i32 box = blur >= 2 ? static_cast<QC::i32>(blur / 2) : 1;
+            const QC::i32 pad = 3 * box;
+            const QC::i32 extent = static_cast<QC::i32>(2 * blur);
+            const QC::i32 n = extent + 2 * pad;
+
+            QC::Vector<QC::u32> line;
+            QC::Vector<QC::u32> scratch;
+            line.resize(static_cast<QC::usize>(n));
+            scratch.resize(static_cast<QC::usize>(n));
+
+            for (QC::i32 i = 0; i < n; ++i)
+                line[i] = (i >= pad + static_cast<QC::i32>(blur)) ? (255u << 8) : 0u;
+
+            const QC::u32 width = static_cast<QC::u32>(2 * box + 1);
+            for (int pass = 0; pass < 3; ++pass)
+            {
+                for (QC::i32 i = 0; i < n; ++i)
+                {
+                    QC::u32 sum = 0;
+                    for (QC::i32 j = -box; j <= box; ++j)
+                    {
+                        QC::i32 k = i + j;
+                        k = k < 0 ? 0 : (k >= n ? n - 1 : k);
+                        sum += line[k];
+                    }
+                    scratch[i] = (sum + width / 2) / width;
+                }
+                for (QC::i32 i = 0; i < n; ++i)
+                    line[i] = scratch[i];
+            }
+
+            for (QC::i32 i = 0; i < extent; ++i)
+                out[i] = (line[pad + i] + 128) >> 8;
+        }
+
+        // Write the top-left corner value for (x, y) into all four quadrants.
+        inline void setMirrored(NinePatch &patch, QC::u32 x, QC::u32 y, QC::u32 value)
+        {
+            const QC::u32 k = patch.extent;
+            const QC::u32 stride = 2 * k;
+            const QC::u32 mx = stride - 1 - x;
+            const QC::u32 my = stride - 1 - y;
+            patch.corners[y * stride + x] = value;
+            patch.corners[y * stride + mx] = value;
+            patch.corners[my * stride + x] = value;
+            patch.corners[my * stride + mx] = value;
+        }
+
+        void allocate(NinePatch &patch, QC::u32 extent)
+        {
+            patch.extent = extent;
+            patch.corners.resize(static_cast<QC::usize>(4) * extent * extent);
+            patch.edgeRow.resize(2 * extent);
+            patch.edgeColumn.resize(2 * extent);
+        }
+
+        void renderRoundedRect(NinePatch &patch, QC::u32 radius, QC::u32 strokeWidth,
+                               QC::Color fill, QC::Color stroke)
+        {
+            const QC::u32 k = radius > strokeWidth ? radius : strokeWidth;
+            allocate(patch, k);
+
+            const QC::u32 fillPremul = premultiplied(fill);
+            const QC::u32 strokePremul = premultiplied(stroke);
+            const QC::i32 outerRadius = static_cast<QC::i32>(radius) * kSubUnit;
+            const QC::i32 inset = static_cast<QC::i32>(strokeWidth) * kSubUnit;
+            const QC::i32 innerRadius = radius > strokeWidth ? static_cast<QC::i32>(radius - strokeWidth) * kSubUnit : 0;
+            const QC::u32 samples = kSubsamples * kSubsamples;
+
+            for (QC::u32 y = 0; y < k; ++y)
+            {
+                for (QC::u32 x = 0; x < k; ++x)
+                {
+                    QC::u32 outer = 0;
+                    QC::u32 inner = 0;
+                    for (QC::i32 sy = 0; sy < kSubsamples; ++sy)
+                    {
+                        const QC::i32 py = static_cast<QC::i32>(y) * kSubUnit + sy * 2 + 1;
+                        for (QC::i32 sx = 0; sx < kSubsamples; ++sx)
+                        {
+                            const QC::i32 px = static_cast<QC::i32>(x) * kSubUnit + sx * 2 + 1;
+                            if (!insideCorner(px, py, 0, outerRadius))
+                                continue;
+                            ++outer;
+                            if (insideCorner(px, py, inset, innerRadius))
+                                ++inner;
+                        }
+                    }
+
+                    setMirrored(patch, x, y, mixPremultiplied(strokePremul, outer - inner, fillPremul, inner, samples));
+                }
+            }
+
+            // Straight edges are pixel aligned: stroke rows, then fill.
+            for (QC::u32 d = 0; d < k; ++d)
+            {
+                const bool inStroke = d < strokeWidth;
+                patch.edgeRow[d] = patch.edgeRow[2 * k - 1 - d] = inStroke ? strokePremul : fillPremul;
+                patch.edgeColumn[d] = patch.edgeColumn[2 * k - 1 - d] = inStroke ? stroke.value : fill.value;
+            }
+            patch.center = fill.value;
+        }
+
+        void renderShadow(NinePatch &patch, QC::u32 blur, QC::Color color)
+        {
+            const QC::u32 k = 2 * blur;
+            allocate(patch, k);
+
+            QC::Vector<QC::u32> profile;
+            profile.resize(k);
+            blurredEdgeProfile(blur, profile.data());
+
+            // A blurred rect is separable: corner coverage is the product of the edge profiles.
+            for (QC::u32 y = 0; y < k; ++y)
+            {
+                for (QC::u32 x = 0; x < k; ++x)
+                {
+                    const QC::u32 alpha = div255(div255(profile[x] * profile[y]) * color.a);
+                    setMirrored(patch, x, y, premultiplied(color.withAlpha(static_cast<QC::u8>(alpha))));
+                }
+            }
+
+            for (QC::u32 d = 0; d < k; ++d)
+            {
+                const QC::Color edge = color.withAlpha(static_cast<QC::u8>(div255(profile[d] * color.a)));
+                patch.edgeRow[d] = patch.edgeRow[2 * k - 1 - d] = premultiplied(edge);
+                patch.edgeColumn[d] = patch.edgeColumn[2 * k - 1 - d] = edge.value;
+            }
+            patch.center = color.value;
+        }
+    } // namespace
+
+    void NinePatch::draw(QC::u32 *pixels, QC::usize pitch, const QC::Rect &rect, const QC::Rect &clip) const
+    {
+        const QC::Rect area = rect.intersection(clip);
+        if (!pixels || area.isEmpty())
+            return;
+
+        const PixelKernels &kernels = PixelKernels::instance();
+        const QC::i32 k = static_cast<QC::i32>(extent);
+        const QC::i32 stride = 2 * k;
+        const QC::i32 left = rect.x + k;
+        const QC::i32 right = rect.right() - k;
+        const QC::i32 top = rect.y + k;
+        const QC::i32 bottom = rect.bottom() - k;
+
+        // Blend one band [x0, x1) of a row, clipped horizontally; `src` is the
+        // premultiplied source for x0, or null for a solid straight-alpha colour.
+        auto band = [&](QC::u32 *row, QC::i32 x0, QC::i32 x1, const QC::u32 *src, QC::u32 solid)
+        {
+            const QC::i32 from = x0 > area.x ? x0 : area.x;
+            const QC::i32 to = x1 < area.right() ? x1 : area.right();
+            if (from >= to)
+                return;
+
+            const QC::usize count = static_cast<QC::usize>(to - from);
+            if (src)
+            {
+                kernels.blendPremultiplied(row + from, src + (from - x0), count);
+                return;
+            }
+
+            const QC::u32 alpha = solid >> 24;
+            if (alpha == 255)
+                kernels.fill(row + from, solid, count);
+            else if (alpha != 0)
+                kernels.blendSolid(row + from, solid, count);
+        };
+
+        for (QC::i32 y = area.y; y < area.bottom(); ++y)
+        {
+            QC::u32 *row = pixels + static_cast<QC::usize>(y) * pitch;
+
+            if (y < top || y >= bottom)
+            {
+                const QC::i32 cornerRow = y < top ? y - rect.y : k + (y - bottom);
+                const QC::u32 *corner = corners.data() + cornerRow * stride;
+                band(row, rect.x, left, corner, 0);
+                band(row, left, right, nullptr, edgeColumn[cornerRow]);
+                band(row, right, rect.right(), corner + k, 0);
+                continue;
+            }
+
+            band(row, rect.x, left, edgeRow.data(), 0);
+            band(row, left, right, nullptr, center);
+            band(row, right, rect.right(), edgeRow.data() + k, 0);
+        }
+    }
+
+    NinePatchCache &NinePatchCache::instance()
+    {
+        static NinePatchCache cache;
+        return cache;
+    }
+
+    NinePatchCache::Entry &NinePatchCache::lookup(Kind kind, QC::u32 size, QC::u32 strokeWidth,
+                                                  QC::u32 color, QC::u32 strokeColor)
+    {
+        ++m_clock;
+
+        Entry *victim = &m_entries[0];
+        for (QC::usize i = 0; i < MaxEntries; ++i)
+        {
+            Entry &entry = m_entries[i];
+            if (entry.used && entry.kind == kind && entry.size == size && entry.strokeWidth == strokeWidth &&
+                entry.color == color && entry.strokeColor == strokeColor)
+            {
+                entry.lastUse = m_clock;
+                return entry;
+            }
+
+            if (!victim->used)
+                continue;
+            if (!entry.used || entry.lastUse < victim->lastUse)
+                victim = &entry;
+        }
+
+        victim->used = false;
+        victim->kind = kind;
+        victim->size = size;
+        victim->strokeWidth = strokeWidth;
+        victim->color = color;
+        victim->strokeColor = strokeColor;
+        victim->lastUse = m_clock;
+        return *victim;
+    }
+
+    const NinePatch *NinePatchCache::roundedRect(QC::u32 radius, QC::u32 strokeWidth,
+                                                 QC::Color fill, QC::Color stroke)
+    {
+        if (radius > MaxExtent || strokeWidth > MaxExtent || (radius == 0 && strokeWidth == 0))
+            return nullptr;
+
+        Entry &entry = lookup(Kind::RoundedRect, radius, strokeWidth, fill.value, stroke.value);
+        if (!entry.used)
+        {
+            renderRoundedRect(entry.patch, radius, strokeWidth, fill, stroke);
+            entry.used = true;
+        }
+        return &entry.patch;
+    }
+
+    const NinePatch *NinePatchCache::shadow(QC::u32 blur, QC::Color color)
+    {
+        if (blur == 0 || blur > MaxExtent)
+            return nullptr;
+
+        Entry &entry = lookup(Kind::Shadow, blur, 0, color.value, 0);
+        if (!entry.used)
+        {
+            renderShadow(entry.patch, blur, color);
+            entry.used = true;
+        }
+        return &entry.patch;
+    }
+
+    const NinePatch *NinePatchCache::roundedRectFor(const QC::Rect &rect, QC::u32 radius, QC::u32 strokeWidth,
+                                                    QC::Color fill, QC::Color stroke)
+    {
+        if (stroke.a == 0)
+            strokeWidth = 0;
+
+        const QC::u32 r = fitExtent(radius, rect);
+        if (r == 0)
+            return nullptr;
+
+        return roundedRect(r, fitExtent(strokeWidth, rect), fill, stroke);
+    }
+
+    const NinePatch *NinePatchCache::shadowFor(const QC::Rect &shadowRect, QC::i32 blurRadius, QC::Color color,
+                                               QC::Rect &patchRect)
+    {
+        // The blur spreads `blur` pixels either side of the edge.
+        const QC::u32 blur = blurRadius > 0 ? fitExtent(static_cast<QC::u32>(blurRadius), shadowRect) : 0;
+        if (blur == 0)
+            return nullptr;
+
+        patchRect = shadowRect.inset(-static_cast<QC::i32>(blur));
+        return shadow(blur, color);
+    }
+
+    void NinePatchCache::clear()
+    {
+        for (QC::usize i = 0; i < MaxEntries; ++i)
+        {
+            m_entries[i].used = false;
+        }
+    }
+
+} // namespace QG
@@ -0,0 +1,380 @@
+// QGraphics PNGKernels - SIMD scanline unfiltering and pixel conversion
+// Namespace: QG
+
+#include "QGPNGKernels.h"
+#include "QArchCPU.h"
+#include "QCMemUtil.h"
+
+#include <immintrin.h>
+
+namespace QG
+{
+
+    namespace
+    {
+        enum : QC::u8
+        {
+            FilterNone = 0,
+            FilterSub = 1,
+            FilterUp = 2,
+            FilterAvg = 3,
+            FilterPaeth = 4
+        };
+
+        // ==================== Scalar ====================
+
+        inline QC::u8 paethPredictor(QC::u8 a, QC::u8 b, QC::u8 c)
+        {
+            const int p = static_cast<int>(a) + static_cast<int>(b) - static_cast<int>(c);
+            const int pa = p > a ? p - a : a - p;
+            const int pb = p > b ? p - b : b - p;
+            const int pc = p > c ? p - c : c - p;
+            if (pa <= pb && pa <= pc)
+                return a;
+            if (pb <= pc)
+                return b;
+            return c;
+        }
+
+        void upScalar(QC::u8 *row, const QC::u8 *prev, QC::usize length)
+        {
+            for (QC::usize i = 0; i < length; ++i)
+                row[i] = static_cast<QC::u8>(row[i] + prev[i]);
+        }
+
+        void subScalar(QC::u8 *row, const QC::u8 *prev, QC::usize length, QC::u32 bpp)
+        {
+            (void)prev;
+            for (QC::usize i = bpp; i < length; ++i)
+                row[i] = static_cast<QC::u8>(row[i] + row[i - bpp]);
+        }
+
+        void avgScalar(QC::u8 *row, const QC::u8 *prev, QC::usize length, QC::u32 bpp)
+        {
+            const QC::usize lead = bpp < length ? bpp : length;
+            for (QC::usize i = 0; i < lead; ++i)
+                row[i] = static_cast<QC::u8>(row[i] + (prev[i] >> 1));
+            for (QC::usize i = bpp; i < length; ++i)
+                row[i] = static_cast<QC::u8>(row[i] + ((row[i - bpp] + prev[i]) >> 1));
+        }
+
+        void paethScalar(QC::u8 *row, const QC::u8 *prev, QC::usize length, QC::u32 bpp)
+        {
+            const QC::usize lead = bpp < length ? bpp : length;
+            for (QC::usize i = 0; i < lead; ++i)
+                row[i] = static_cast<QC::u8>(row[i] + prev[i]); // a = c = 0 picks b
+            for (QC::usize i = bpp; i < length; ++i)
+                row[i] = static_cast<QC::u8>(row[i] + paethPredictor(row[i - bpp], prev[i], prev[i - bpp]));
+        }
+
+        // PNG stores R, G, B, A; QC::Color is B, G, R, A in memory.
+        void convertRGBAScalar(QC::u32 *dst, const QC::u8 *src, QC::usize count)
+        {
+            for (QC::usize i = 0; i < count; ++i, src += 4)
+            {
+                dst[i] = (static_cast<QC::u32>(src[3]) << 24) | (static_cast<QC::u32>(src[0]) << 16) |
+                         (static_cast<QC::u32>(src[1]) << 8) | src[2];
+            }
+        }
+
+        void convertRGBScalar(QC::u32 *dst, const QC::u8 *src, QC::usize count)
+        {
+            for (QC::usize i = 0; i < count; ++i, src += 3)
+            {
+                dst[i] = 0xFF000000u | (static_cast<QC::u32>(src[0]) << 16) |
+                         (static_cast<QC::u32>(src[1]) << 8) | src[2];
+            }
+        }
+
+        void convertGrayScalar(QC::u32 *dst, const QC::u8 *src, QC::usize count)
+        {
+            for (QC::usize i = 0; i < count; ++i)
+                dst[i] = 0xFF000000u | (static_cast<QC::u32>(src[i]) * 0x010101u);
+        }
+
+        // ==================== SSE2 ====================
+        // Sub/Avg/Paeth carry a dependency from each pixel to the next, so these
+        // process one 3- or 4-byte pixel per step with all channels in parallel.
+
+        inline QC::u32 loadPixel(const QC::u8 *p, QC::u32 bpp)
+        {
+            QC::u32 v = 0;
+            memcpy(&v, p, bpp);
+            return v;
+        }
+
+        inline void storePixel(QC::u8 *p, QC::u32 v, QC::u32 bpp)
+        {
+            memcpy(p, &v, bpp);
+        }
+
+        __attribute__((target("sse2"))) void upSSE2(QC::u8 *row, const QC::u8 *prev, QC::usize length)
+        {
+            QC::usize i = 0;
+            for (; i + 16 <= length; i += 16)
+            {
+                const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + i));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(prev + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(row + i), _mm_add_epi8(x, b));
+            }
+            upScalar(row + i, prev + i, length - i);
+        }
+
+        __attribute__((target("sse2"))) void subSSE2(QC::u8 *row, const QC::u8 *prev, QC::usize length, QC::u32 bpp)
+        {
+            if (bpp != 3 && bpp != 4)
+            {
+                subScalar(row, prev, length, bpp);
+                return;
+            }
+
+            __m128i a = _mm_setzero_si128();
+            for (QC::usize i = 0; i + bpp <= length; i += bpp)
+            {
+                a = _mm_add_epi8(a, _mm_cvtsi32_si128(static_cast<int>(loadPixel(row + i, bpp))));
+                storePixel(row + i, static_cast<QC::u32>(_mm_cvtsi128_si32(a)), bpp);
+            }
+        }
+
+        __attribute__((target("sse2"))) void avgSSE2(QC::u8 *row, const QC::u8 *prev, QC::usize length, QC::u32 bpp)
+        {
+            if (bpp != 3 && bpp != 4)
+            {
+                avgScalar(row, prev, length, bpp);
+                return;
+            }
+
+            const __m128i one = _mm_set1_epi8(1);
+            __m128i a = _mm_setzero_si128();
+            for (QC::usize i = 0; i + bpp <= length; i += bpp)
+            {
+                const __m128i b = _mm_cvtsi32_si128(static_cast<int>(loadPixel(prev + i, bpp)));
+                const __m128i x = _mm_cvtsi32_si128(static_cast<int>(loadPixel(row + i, bpp)));
+
+                // pavgb rounds up; subtract the odd bit to get floor((a + b) / 2).
+                const __m128i avg = _mm_sub_epi8(_mm_avg_epu8(a, b), _mm_and_si128(_mm_xor_si128(a, b), one));
+                a = _mm_add_epi8(x, avg);
+                storePixel(row + i, static_cast<QC::u32>(_mm_cvtsi128_si32(a)), bpp);
+            }
+        }
+
+        __attribute__((target("sse2"))) inline __m128i abs16SSE2(__m128i x)
+        {
+            return _mm_max_epi16(x, _mm_sub_epi16(_mm_setzero_si128(), x));
+        }
+
+        __attribute__((target("sse2"))) inline __m128i selectSSE2(__m128i mask, __m128i yes, __m128i no)
+        {
+            return _mm_or_si128(_mm_and_si128(mask, yes), _mm_andnot_si128(mask, no));
+        }
+
+        __attribute__((target("sse2"))) void paethSSE2(QC::u8 *row, const QC::u8 *prev, QC::usize length, QC::u32 bpp)
+        {
+            if (bpp != 3 && bpp != 4)
+            {
+                paethScalar(row, prev, length, bpp);
+                return;
+            }
+
+            // Channels widened to 16 bits so the predictor distances cannot overflow.
+            const __m128i zero = _mm_setzero_si128();
+            __m128i a = zero;
+            __m128i c = zero;
+            for (QC::usize i = 0; i + bpp <= length; i += bpp)
+            {
+                const __m128i b = _mm_unpacklo_epi8(_mm_cvtsi32_si128(static_cast<int>(loadPixel(prev + i, bpp))), zero);
+                const __m128i x = _mm_unpacklo_epi8(_mm_cvtsi32_si128(static_cast<int>(loadPixel(row + i, bpp))), zero);
+
+                // |p - a| = |b - c|, |p - b| = |a - c|, |p - c| = |(b - c) + (a - c)|
+                const __m128i bc = _mm_sub_epi16(b, c);
+                const __m128i ac = _mm_sub_epi16(a, c);
+                const __m128i pa = abs16SSE2(bc);
+                const __m128i pb = abs16SSE2(ac);
+                const __m128i pc = abs16SSE2(_mm_add_epi16(bc, ac));
+                const __m128i smallest = _mm_min_epi16(pc, _mm_min_epi16(pa, pb));
+
+                const __m128i predictor = selectSSE2(_mm_cmpeq_epi16(smallest, pa), a,
+                                                     selectSSE2(_mm_cmpeq_epi16(smallest, pb), b, c));
+                const __m128i sum = _mm_and_si128(_mm_add_epi16(x, predictor), _mm_set1_epi16(0xFF));
+
+                storePixel(row + i, static_cast<QC::u32>(_mm_cvtsi128_si32(_mm_packus_epi16(sum, sum))), bpp);
+                a = sum;
+                c = b;
+            }
+        }
+
+        __attribute__((target("sse2"))) void convertRGBASSE2(QC::u32 *dst, const QC::u8 *src, QC::usize count)
+        {
+            // Swap bytes 0 and 2 of each pixel with shifts: R,B live in 0x00FF00FF.
+            const __m128i rbMask = _mm_set1_epi32(0x00FF00FF);
+            QC::usize i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 4));
+                const __m128i ga = _mm_andnot_si128(rbMask, x);
+                const __m128i rb = _mm_and_si128(rbMask, x);
+                const __m128i br = _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_or_si128(ga, _mm_and_si128(br, rbMask)));
+            }
+            convertRGBAScalar(dst + i, src + i * 4, count - i);
+        }
+
+        __attribute__((target("sse2"))) void convertGraySSE2(QC::u32 *dst, const QC::u8 *src, QC::usize count)
+        {
+            const __m128i opaque = _mm_set1_epi8(static_cast<char>(0xFF));
+            QC::usize i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                const __m128i g = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+                const __m128i ggLo = _mm_unpacklo_epi8(g, g);
+                const __m128i ggHi = _mm_unpackhi_epi8(g, g);
+                const __m128i gaLo = _mm_unpacklo_epi8(g, opaque);
+                const __m128i gaHi = _mm_unpackhi_epi8(g, opaque);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_unpacklo_epi16(ggLo, gaLo));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + 4), _mm_unpackhi_epi16(ggLo, gaLo));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + 8), _mm_unpacklo_epi16(ggHi, gaHi));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + 12), _mm_unpackhi_epi16(ggHi, gaHi));
+            }
+            convertGrayScalar(dst + i, src + i, count - i);
+        }
+
+        // ==================== SSSE3 (byte shuffles) ====================
+
+        __attribute__((target("ssse3"))) void convertRGBASSSE3(QC::u32 *dst, const QC::u8 *src, QC::usize count)
+        {
+            const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+            QC::usize i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 4));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_shuffle_epi8(x, shuffle));
+            }
+            convertRGBAScalar(dst + i, src + i * 4, count - i);
+        }
+
+        __attribute__((target("ssse3"))) void convertRGBSSSE3(QC::u32 *dst, const QC::u8 *src, QC::usize count)
+        {
+            // 12 source bytes make 4 pixels; the 16-byte load must stay inside the row.
+            const __m128i shuffle = _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+            const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+            QC::usize i = 0;
+            for (; (i + 4) * 3 + 4 <= count * 3; i += 4)
+            {
+                const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i * 3));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_or_si128(_mm_shuffle_epi8(x, shuffle), alpha));
+            }
+            convertRGBScalar(dst + i, src + i * 3, count - i);
+        }
+
+        // ==================== AVX2 ====================
+
+        __attribute__((target("avx2"))) void upAVX2(QC::u8 *row, const QC::u8 *prev, QC::usize length)
+        {
+            QC::usize i = 0;
+            for (; i + 32 <= length; i += 32)
+            {
+                const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row + i));
+                const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(prev + i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(row + i), _mm256_add_epi8(x, b));
+            }
+            upScalar(row + i, prev + i, length - i);
+        }
+
+        __attribute__((target("avx2"))) void convertRGBAAVX2(QC::u32 *dst, const QC::u8 *src, QC::usize count)
+        {
+            const __m256i shuffle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+                                                     2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+            QC::usize i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i * 4));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_shuffle_epi8(x, shuffle));
+            }
+            convertRGBASSSE3(dst + i, src + i * 4, count - i);
+        }
+    } // namespace
+
+    PNGKernels &PNGKernels::instance()
+    {
+        static PNGKernels kernels;
+        return kernels;
+    }
+
+    PNGKernels::PNGKernels()
+        : m_up(upScalar),
+          m_sub(subScalar),
+          m_avg(avgScalar),
+          m_paeth(paethScalar),
+          m_convertRGBA(convertRGBAScalar),
+          m_convertRGB(convertRGBScalar),
+          m_convertGray(convertGrayScalar),
+          m_isa(PixelIsa::Scalar)
+    {
+        select();
+    }
+
+    void PNGKernels::select()
+    {
+        auto &cpu = QArch::CPU::instance();
+        const QArch::CPUFeatures &features = cpu.features();
+
+        if (!features.sse2)
+        {
+            m_up = upScalar;
+            m_sub = subScalar;
+            m_avg = avgScalar;
+            m_paeth = paethScalar;
+            m_convertRGBA = convertRGBAScalar;
+            m_convertRGB = convertRGBScalar;
+            m_convertGray = convertGrayScalar;
+            m_isa = PixelIsa::Scalar;
+            return;
+        }
+
+        m_up = upSSE2;
+        m_sub = subSSE2;
+        m_avg = avgSSE2;
+        m_paeth = paethSSE2;
+        m_convertRGBA = convertRGBASSE2;
+        m_convertRGB = convertRGBScalar;
+        m_convertGray = convertGraySSE2;
+        m_isa = PixelIsa::SSE2;
+
+        if (features.ssse3)
+        {
+            m_convertRGBA = convertRGBASSSE3;
+            m_convertRGB = convertRGBSSSE3;
+        }
+
+        if (features.avx2 && features.ssse3 && cpu.avxStateEnabled())
+        {
+            m_up = upAVX2;
+            m_convertRGBA = convertRGBAAVX2;
+            m_isa = PixelIsa::AVX2;
+        }
+    }
+
+    bool PNGKernels::unfilter(QC::u8 filter, QC::u8 *row, const QC::u8 *prev, QC::usize length, QC::u32 bpp) const
+    {
+        switch (filter)
+        {
+        case FilterNone:
+            return true;
+        case FilterSub:
+            m_sub(row, prev, length, bpp);
+            return true;
+        case FilterUp:
+            m_up(row, prev, length);
+            return true;
+        case FilterAvg:
+            m_avg(row, prev, length, bpp);
+            return true;
+        case FilterPaeth:
+            m_paeth(row, prev, length, bpp);
+            return true;
+        default:
+            return false;
+        }
+    }
+
+} // namespace QG
@@ -1,6 +1,5 @@
 #include "QG/PainterSurface.h"
-
-#include <algorithm>
+#include "QGPixelKernels.h"
 
 namespace QG
 {
@@ -186,6 +185,92 @@ namespace QG
             }
         }
 
+        /// One lit rectangle of a glyph, in unscaled font pixels
+        struct GlyphRect
+        {
+            QC::u8 x, y, width, height;
+        };
+
+        /// A glyph pre-rasterised into rectangles: horizontal runs of lit bits,
+        /// merged with identical runs directly below.
+        struct GlyphSpans
+        {
+            static constexpr QC::usize MaxRects = 21; // 7 rows x at most 3 runs
+
+            GlyphRect rects[MaxRects];
+            QC::u8 count = 0;
+        };
+
+        /// GlyphAtlas - span form of every 5x7 glyph, built once on first use.
+        /// The font is 1-bit, so spans are shared across colours and scaled at
+        /// draw time by multiplying the rect.
+        class GlyphAtlas
+        {
+        public:
+            static const GlyphAtlas &instance()
+            {
+                static GlyphAtlas atlas;
+                return atlas;
+            }
+
+            const GlyphSpans &glyph(char c) const
+            {
+                const QC::u8 index = static_cast<QC::u8>(c);
+                return index < 128 ? m_glyphs[index] : m_fallback;
+            }
+
+        private:
+            GlyphAtlas()
+            {
+                for (QC::u32 i = 0; i < 128; ++i)
+                {
+                    build(glyphForChar(static_cast<char>(i)), m_glyphs[i]);
+                }
+                build(glyphForChar('\x7F'), m_fallback);
+            }
+
+            static void build(const Glyph5x7 &g, GlyphSpans &out)
+            {
+                out.count = 0;
+                for (QC::u8 row = 0; row < 7; ++row)
+                {
+                    const QC::u8 bits = g.rows[row];
+                    QC::u8 col = 0;
+                    while (col < 5)
+                    {
+                        if (!(bits & (1u << col)))
+                        {
+                            ++col;
+                            continue;
+                        }
+
+                        QC::u8 start = col;
+                        while (col < 5 && (bits & (1u << col)))
+                            ++col;
+                        const QC::u8 width = static_cast<QC::u8>(col - start);
+
+                        // Extend a rect ending on the previous row with the same run.
+                        bool merged = false;
+                        for (QC::u8 i = 0; i < out.count; ++i)
+                        {
+                            GlyphRect &r = out.rects[i];
+                            if (r.x == start && r.width == width && r.y + r.height == row)
+                            {
+                                ++r.height;
+                                merged = true;
+                                break;
+                            }
+                        }
+                        if (!merged)
+                            out.rects[out.count++] = GlyphRect{start, row, width, 1};
+                    }
+                }
+            }
+
+            GlyphSpans m_glyphs[128];
+            GlyphSpans m_fallback;
+        };
+
         inline QC::Size measureTextMono5x7(const char *text)
         {
             if (!text)
@@ -220,45 +305,6 @@ namespace QG
         }
     } // namespace
 
-    namespace
-    {
-        inline QC::u8 gradientChannel(QC::u8 start, QC::u8 end, QC::i32 step, QC::i32 segments)
-        {
-            if (segments <= 0)
-                return start;
-
-            QC::i32 diff = static_cast<QC::i32>(end) - static_cast<QC::i32>(start);
-            QC::i64 scaled = static_cast<QC::i64>(diff) * static_cast<QC::i64>(step);
-
-            QC::i64 roundTerm = segments / 2;
-            if (scaled < 0)
-                scaled -= roundTerm;
-            else
-                scaled += roundTerm;
-
-            QC::i32 delta = static_cast<QC::i32>(scaled / segments);
-            QC::i32 value = static_cast<QC::i32>(start) + delta;
-
-            if (value < 0)
-                value = 0;
-            else if (value > 255)
-                value = 255;
-
-            return static_cast<QC::u8>(value);
-        }
-
-        inline QC::Color gradientColor(const QC::Color &a, const QC::Color &b, QC::i32 step, QC::i32 segments)
-        {
-            if (segments <= 0)
-                return a;
-
-            return QC::Color(
-                gradientChannel(a.r, b.r, step, segments),
-                gradientChannel(a.g, b.g, step, segments),
-                gradientChannel(a.b, b.b, step, segments),
-                gradientChannel(a.a, b.a, step, segments));
-        }
-    } // namespace
 
     PainterSurface::PainterSurface(QC::u32 *pixels,
                                    QC::u32 width,
@@ -457,11 +503,8 @@ namespace QG
         if (x1 >= x2)
             return;
 
-        QC::u32 *row = m_pixels + y * m_pitch;
-        for (QC::i32 px = x1; px < x2; ++px)
-        {
-            row[px] = color.value;
-        }
+        PixelKernels::instance().fill(m_pixels + y * m_pitch + x1, color.value,
+                                      static_cast<QC::usize>(x2 - x1));
     }
 
     void PainterSurface::drawVLine(QC::i32 x, QC::i32 y, QC::u32 length, QC::Color color)
@@ -549,33 +592,25 @@ namespace QG
 
         if (brush.style() == BrushStyle::Solid)
         {
-            QC::Color color = brush.color();
-            for (QC::i32 yy = y1; yy < y2; ++yy)
-            {
-                QC::u32 *row = m_pixels + yy * m_pitch;
-                for (QC::i32 xx = x1; xx < x2; ++xx)
-                {
-                    row[xx] = color.value;
-                }
-            }
+            PixelKernels::instance().fillRect(m_pixels, m_pitch,
+                                              QC::Rect(x1, y1,
+                                                       static_cast<QC::u32>(x2 - x1),
+                                                       static_cast<QC::u32>(y2 - y1)),
+                                              brush.color().value);
             return;
         }
 
+        // Gradients are laid out over the unclipped rect so a clipped repaint
+        // reproduces exactly the pixels of a full one.
         if (brush.style() == BrushStyle::LinearGradientV)
         {
-            fillGradientV(QC::Rect(x1, y1,
-                                   static_cast<QC::u32>(x2 - x1),
-                                   static_cast<QC::u32>(y2 - y1)),
-                          brush.color(), brush.colorEnd());
+            fillGradientV(rect, brush.color(), brush.colorEnd());
             return;
         }
 
         if (brush.style() == BrushStyle::LinearGradientH)
         {
-            fillGradientH(QC::Rect(x1, y1,
-                                   static_cast<QC::u32>(x2 - x1),
-                                   static_cast<QC::u32>(y2 - y1)),
-                          brush.color(), brush.colorEnd());
+            fillGradientH(rect, brush.color(), brush.colorEnd());
         }
     }
 
@@ -673,20 +708,14 @@ namespace QG
         if (x1 >= x2 || y1 >= y2)
             return;
 
-        QC::i32 height = y2 - y1;
-        if (height <= 0)
-            return;
-
-        QC::i32 segments = height > 1 ? height - 1 : 0;
+        const QC::i32 segments = r.height > 1 ? static_cast<QC::i32>(r.height) - 1 : 0;
+        const PixelKernels &kernels = PixelKernels::instance();
+        const QC::usize span = static_cast<QC::usize>(x2 - x1);
 
-        for (QC::i32 y = y1, step = 0; y < y2; ++y, ++step)
+        for (QC::i32 y = y1; y < y2; ++y)
         {
-            QC::Color color = segments > 0 ? gradientColor(top, bottom, step, segments) : top;
-            QC::u32 *row = m_pixels + y * m_pitch;
-            for (QC::i32 x = x1; x < x2; ++x)
-            {
-                row[x] = color.value;
-            }
+            const QC::Color color = PixelKernels::gradientColor(top, bottom, y - r.y, segments);
+            kernels.fill(m_pixels + y * m_pitch + x1, color.value, span);
         }
     }
 
@@ -726,21 +755,16 @@ namespace QG
         if (x1 >= x2 || y1 >= y2)
             return;
 
-        QC::i32 width = x2 - x1;
-        if (width <= 0)
-            return;
-
-        QC::i32 segments = width > 1 ? width - 1 : 0;
+        // Every row is identical: generate the first, copy it to the rest.
+        const QC::i32 segments = r.width > 1 ? static_cast<QC::i32>(r.width) - 1 : 0;
+        const PixelKernels &kernels = PixelKernels::instance();
+        const QC::usize span = static_cast<QC::usize>(x2 - x1);
 
-        for (QC::i32 y = y1; y < y2; ++y)
+        QC::u32 *first = m_pixels + y1 * m_pitch + x1;
+        kernels.gradient(first, left, right, x1 - r.x, segments, span);
+        for (QC::i32 y = y1 + 1; y < y2; ++y)
         {
-            QC::u32 *row = m_pixels + y * m_pitch;
-            QC::i32 step = 0;
-            for (QC::i32 x = x1; x < x2; ++x, ++step)
-            {
-                QC::Color color = segments > 0 ? gradientColor(left, right, step, segments) : left;
-                row[x] = color.value;
-            }
+            kernels.copy(m_pixels + y * m_pitch + x1, first, span);
         }
     }
 
@@ -749,38 +773,27 @@ namespace QG
         if (!text || !m_pixels || m_pitch == 0)
             return;
 
+        QC::Rect clip = bounds();
+        if (!clipSpanRect(clip))
+            return;
+
         const QC::i32 scale = textPixelScale();
         const QC::i32 advanceX = kGlyphW * scale;
         const QC::i32 advanceY = kGlyphH * scale;
 
-        QC::i32 cursorX = x;
-        QC::i32 cursorY = y;
+        QC::i32 cursorX = x + m_origin.x;
+        QC::i32 cursorY = y + m_origin.y;
 
         for (const char *p = text; *p; ++p)
         {
             if (*p == '\n')
             {
-                cursorX = x;
+                cursorX = x + m_origin.x;
                 cursorY += advanceY;
                 continue;
             }
 
-            const Glyph5x7 g = glyphForChar(*p);
-            for (QC::i32 row = 0; row < 7; ++row)
-            {
-                QC::u8 bits = g.rows[row];
-                for (QC::i32 col = 0; col < 5; ++col)
-                {
-                    if (bits & (1u << col))
-                    {
-                        stampGlyphPixel(cursorX + col * scale,
-                                        cursorY + row * scale,
-                                        scale,
-                                        color);
-                    }
-                }
-            }
-
+            drawGlyph(*p, cursorX, cursorY, scale, color, clip);
             cursorX += advanceX;
         }
     }
@@ -809,7 +822,9 @@ namespace QG
 
         const bool hadClip = m_hasClip;
         const QC::Rect oldClip = m_clip;
-        setClipRect(rect.offset(m_origin.x, m_origin.y));
+        // Narrow, never widen, an outer clip (e.g. the window's dirty area).
+        const QC::Rect textClip = rect.offset(m_origin.x, m_origin.y);
+        setClipRect(hadClip ? textClip.intersection(oldClip) : textClip);
 
         if (format.ellipsis && static_cast<QC::i32>(rect.width) > 0)
         {
@@ -828,39 +843,23 @@ namespace QG
                     if (keep < 0)
                         keep = 0;
 
-                    QC::i32 cursorX = startX;
-                    QC::i32 cursorY = startY;
-                    const char *p = text;
-                    for (QC::i32 i = 0; i < keep && *p && *p != '\n'; ++i, ++p)
+                    QC::Rect clip = bounds();
+                    if (clipSpanRect(clip))
                     {
-                        const Glyph5x7 g = glyphForChar(*p);
-                        for (QC::i32 row = 0; row < 7; ++row)
+                        QC::i32 cursorX = startX + m_origin.x;
+                        const QC::i32 cursorY = startY + m_origin.y;
+                        const char *p = text;
+                        for (QC::i32 i = 0; i < keep && *p && *p != '\n'; ++i, ++p)
                         {
-                            QC::u8 bits = g.rows[row];
-                            for (QC::i32 col = 0; col < 5; ++col)
-                                if (bits & (1u << col))
-                                    stampGlyphPixel(cursorX + col * scale,
-                                                    cursorY + row * scale,
-                                                    scale,
-                                                    color);
+                            drawGlyph(*p, cursorX, cursorY, scale, color, clip);
+                            cursorX += glyphAdvance;
                         }
-                        cursorX += glyphAdvance;
-                    }
 
-                    for (QC::i32 i = 0; i < dots; ++i)
-                    {
-                        const Glyph5x7 g = glyphForChar('.');
-                        for (QC::i32 row = 0; row < 7; ++row)
+                        for (QC::i32 i = 0; i < dots; ++i)
                         {
-                            QC::u8 bits = g.rows[row];
-                            for (QC::i32 col = 0; col < 5; ++col)
-                                if (bits & (1u << col))
-                                    stampGlyphPixel(cursorX + col * scale,
-                                                    cursorY + row * scale,
-                                                    scale,
-                                                    color);
+                            drawGlyph('.', cursorX, cursorY, scale, color, clip);
+                            cursorX += glyphAdvance;
                         }
-                        cursorX += glyphAdvance;
                     }
 
                     if (hadClip)
@@ -887,9 +886,22 @@ namespace QG
         return QC::Size(base.width * scale, base.height * scale);
     }
 
-    void PainterSurface::blit(QC::i32 x, QC::i32 y,
-                              const QC::u32 *pixels, QC::u32 width, QC::u32 height,
-                              QC::u32 stride)
+    bool PainterSurface::clipSpanRect(QC::Rect &rect) const
+    {
+        QC::Rect clipped = rect.intersection(bounds());
+        if (m_hasClip)
+            clipped = clipped.intersection(m_clip);
+
+        if (clipped.isEmpty())
+            return false;
+
+        rect = clipped;
+        return true;
+    }
+
+    void PainterSurface::blitRows(QC::i32 x, QC::i32 y,
+                                  const QC::u32 *pixels, QC::u32 width, QC::u32 height,
+                                  QC::u32 stride, SurfaceFormat format)
     {
         if (!m_pixels || !pixels || m_pitch == 0)
             return;
@@ -900,91 +912,62 @@ namespace QG
         x += m_origin.x;
         y += m_origin.y;
 
-        for (QC::u32 row = 0; row < height; ++row)
-        {
-            QC::i32 destY = y + static_cast<QC::i32>(row);
-            if (destY < 0 || static_cast<QC::u32>(destY) >= m_height)
-                continue;
-
-            if (m_hasClip)
-            {
-                QC::i32 clipTop = m_clip.y;
-                QC::i32 clipBottom = m_clip.y + static_cast<QC::i32>(m_clip.height);
-                if (destY < clipTop || destY >= clipBottom)
-                    continue;
-            }
+        // Clip once, then process whole rows.
+        QC::Rect dest(x, y, width, height);
+        if (!clipSpanRect(dest))
+            return;
 
-            const QC::u32 *srcRow = pixels + row * stride;
-            QC::u32 *destRow = m_pixels + destY * m_pitch;
+        const PixelKernels &kernels = PixelKernels::instance();
+        const QC::u32 *srcRow = pixels + static_cast<QC::usize>(dest.y - y) * stride + (dest.x - x);
+        QC::u32 *destRow = m_pixels + dest.y * m_pitch + dest.x;
 
-            for (QC::u32 col = 0; col < width; ++col)
+        for (QC::u32 row = 0; row < dest.height; ++row, srcRow += stride, destRow += m_pitch)
+        {
+            switch (format)
             {
-                QC::i32 destX = x + static_cast<QC::i32>(col);
-                if (destX < 0 || static_cast<QC::u32>(destX) >= m_width)
-                    continue;
-
-                if (m_hasClip)
-                {
-                    QC::i32 clipLeft = m_clip.x;
-                    QC::i32 clipRight = m_clip.x + static_cast<QC::i32>(m_clip.width);
-                    if (destX < clipLeft || destX >= clipRight)
-                        continue;
-                }
-
-                destRow[destX] = srcRow[col];
+            case SurfaceFormat::Opaque:
+                kernels.copy(destRow, srcRow, dest.width);
+                break;
+            case SurfaceFormat::Premultiplied:
+                kernels.blendPremultiplied(destRow, srcRow, dest.width);
+                break;
+            case SurfaceFormat::Straight:
+                kernels.blend(destRow, srcRow, dest.width);
+                break;
             }
         }
     }
 
+    void PainterSurface::blit(QC::i32 x, QC::i32 y,
+                              const QC::u32 *pixels, QC::u32 width, QC::u32 height,
+                              QC::u32 stride)
+    {
+        blitRows(x, y, pixels, width, height, stride, SurfaceFormat::Opaque);
+    }
+
     void PainterSurface::blitAlpha(QC::i32 x, QC::i32 y,
                                    const QC::u32 *pixels, QC::u32 width, QC::u32 height,
                                    QC::u32 stride)
     {
-        if (!m_pixels || !pixels || m_pitch == 0)
-            return;
-
-        if (stride == 0)
-            stride = width;
-
-        x += m_origin.x;
-        y += m_origin.y;
-
-        for (QC::u32 row = 0; row < height; ++row)
-        {
-            QC::i32 destY = y + static_cast<QC::i32>(row);
-            if (destY < 0 || static_cast<QC::u32>(destY) >= m_height)
-                continue;
-
-            if (m_hasClip)
-            {
-                QC::i32 clipTop = m_clip.y;
-                QC::i32 clipBottom = m_clip.y + static_cast<QC::i32>(m_clip.height);
-                if (destY < clipTop || destY >= clipBottom)
-                    continue;
-            }
-
-            const QC::u32 *srcRow = pixels + row * stride;
-            QC::u32 *destRow = m_pixels + destY * m_pitch;
+        blitRows(x, y, pixels, width, height, stride, SurfaceFormat::Straight);
+    }
 
-            for (QC::u32 col = 0; col < width; ++col)
-            {
-                QC::i32 destX = x + static_cast<QC::i32>(col);
-                if (destX < 0 || static_cast<QC::u32>(destX) >= m_width)
-                    continue;
+    void PainterSurface::blitPremultiplied(QC::i32 x, QC::i32 y,
+                                           const QC::u32 *pixels, QC::u32 width, QC::u32 height,
+                                           QC::u32 stride)
+    {
+        blitRows(x, y, pixels, width, height, stride, SurfaceFormat::Premultiplied);
+    }
 
-                if (m_hasClip)
-                {
-                    QC::i32 clipLeft = m_clip.x;
-                    QC::i32 clipRight = m_clip.x + static_cast<QC::i32>(m_clip.width);
-                    if (destX < clipLeft || destX >= clipRight)
-                        continue;
-                }
+    bool PainterSurface::scrollRect(const QC::Rect &rect, QC::i32 dx, QC::i32 dy)
+    {
+        if (!m_pixels || m_pitch == 0)
+            return false;
 
-                QC::Color src(srcRow[col]);
-                QC::Color dst(destRow[destX]);
-                destRow[destX] = src.blend(dst).value;
-            }
-        }
+        QC::Rect r = rect.offset(m_origin.x, m_origin.y);
+        if (clipSpanRect(r))
+            PixelKernels::instance().moveRect(m_pixels, m_pitch, r, dx, dy);
+        return true;
     }
 
     void PainterSurface::clear(QC::Color color)
@@ -992,11 +975,11 @@ namespace QG
         if (!m_pixels || m_pitch == 0)
             return;
 
-        for (QC::u32 y = 0; y < m_height; ++y)
-        {
-            QC::u32 *row = m_pixels + y * m_pitch;
-            std::fill(row, row + m_width, color.value);
-        }
+        QC::Rect r = bounds();
+        if (!clipSpanRect(r))
+            return;
+
+        PixelKernels::instance().fillRect(m_pixels, m_pitch, r, color.value);
     }
 
     bool PainterSurface::inClip(QC::i32 x, QC::i32 y) const
@@ -1024,20 +1007,26 @@ namespace QG
         return (rounded < 1) ? 1 : rounded;
     }
 
-    void PainterSurface::stampGlyphPixel(QC::i32 baseX, QC::i32 baseY, QC::i32 scale, QC::Color color)
+    void PainterSurface::drawGlyph(char c, QC::i32 x, QC::i32 y, QC::i32 scale,
+                                   QC::Color color, const QC::Rect &clip)
     {
-        if (scale <= 1)
-        {
-            setPixel(baseX, baseY, color);
+        // Surface coordinates; `clip` is already inside the surface.
+        if (x >= clip.right() || y >= clip.bottom() ||
+            x + 5 * scale <= clip.x || y + 7 * scale <= clip.y)
             return;
-        }
 
-        for (QC::i32 y = 0; y < scale; ++y)
+        const GlyphSpans &spans = GlyphAtlas::instance().glyph(c);
+        const PixelKernels &kernels = PixelKernels::instance();
+
+        for (QC::u8 i = 0; i < spans.count; ++i)
         {
-            for (QC::i32 x = 0; x < scale; ++x)
-            {
-                setPixel(baseX + x, baseY + y, color);
-            }
+            const GlyphRect &g = spans.rects[i];
+            const QC::Rect r = QC::Rect(x + g.x * scale, y + g.y * scale,
+                                        static_cast<QC::u32>(g.width * scale),
+                                        static_cast<QC::u32>(g.height * scale))
+                                   .intersection(clip);
+            if (!r.isEmpty())
+                kernels.fillRect(m_pixels, m_pitch, r, color.value);
         }
     }
 
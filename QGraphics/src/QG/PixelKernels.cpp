@@ -0,0 +1,695 @@
+// QGraphics PixelKernels - SIMD span primitives implementation
+// Namespace: QG
+
+#include "QGPixelKernels.h"
+#include "QArchCPU.h"
+#include "QCMemUtil.h"
+
+#include <immintrin.h>
+
+namespace QG
+{
+
+    namespace
+    {
+        // Exact x / 255 for 0 <= x <= 65025 (the range of a * b with 8-bit inputs).
+        inline QC::u32 div255(QC::u32 x)
+        {
+            return (x + 1 + (x >> 8)) >> 8;
+        }
+
+        // ==================== Scalar ====================
+
+        void fillScalar(QC::u32 *dst, QC::u32 value, QC::usize count)
+        {
+            for (QC::usize i = 0; i < count; ++i)
+                dst[i] = value;
+        }
+
+        void copyScalar(QC::u32 *dst, const QC::u32 *src, QC::usize count)
+        {
+            for (QC::usize i = 0; i < count; ++i)
+                dst[i] = src[i];
+        }
+
+        inline QC::u32 blendPixel(QC::u32 s, QC::u32 d)
+        {
+            const QC::u32 a = s >> 24;
+            if (a == 255)
+                return s;
+            if (a == 0)
+                return d;
+
+            // The source alpha channel counts as 255 so the result alpha is
+            // a + da * (255 - a) / 255, exactly like QC::Color::blend.
+            const QC::u32 ia = 255 - a;
+            const QC::u32 s1 = s | 0xFF000000u;
+            QC::u32 out = 0;
+            for (QC::u32 shift = 0; shift < 32; shift += 8)
+            {
+                const QC::u32 sc = (s1 >> shift) & 0xFF;
+                const QC::u32 dc = (d >> shift) & 0xFF;
+                out |= div255(sc * a + dc * ia) << shift;
+            }
+            return out;
+        }
+
+        void blendScalar(QC::u32 *dst, const QC::u32 *src, QC::usize count)
+        {
+            for (QC::usize i = 0; i < count; ++i)
+                dst[i] = blendPixel(src[i], dst[i]);
+        }
+
+        void blendSolidScalar(QC::u32 *dst, QC::u32 color, QC::usize count)
+        {
+            for (QC::usize i = 0; i < count; ++i)
+                dst[i] = blendPixel(color, dst[i]);
+        }
+
+        inline QC::u32 blendPremultipliedPixel(QC::u32 s, QC::u32 d)
+        {
+            const QC::u32 a = s >> 24;
+            if (a == 255)
+                return s;
+            if (s == 0)
+                return d;
+
+            const QC::u32 ia = 255 - a;
+            QC::u32 out = 0;
+            for (QC::u32 shift = 0; shift < 32; shift += 8)
+            {
+                QC::u32 c = ((s >> shift) & 0xFF) + div255(((d >> shift) & 0xFF) * ia);
+                if (c > 255)
+                    c = 255;
+                out |= c << shift;
+            }
+            return out;
+        }
+
+        void blendPremultipliedScalar(QC::u32 *dst, const QC::u32 *src, QC::usize count)
+        {
+            for (QC::usize i = 0; i < count; ++i)
+                dst[i] = blendPremultipliedPixel(src[i], dst[i]);
+        }
+
+        void downsample2xScalar(QC::u32 *dst, const QC::u32 *row0, const QC::u32 *row1, QC::usize count)
+        {
+            for (QC::usize i = 0; i < count; ++i)
+            {
+                const QC::u32 a = row0[2 * i], b = row0[2 * i + 1];
+                const QC::u32 c = row1[2 * i], d = row1[2 * i + 1];
+                QC::u32 out = 0;
+                for (QC::u32 shift = 0; shift < 32; shift += 8)
+                {
+                    const QC::u32 sum = ((a >> shift) & 0xFF) + ((b >> shift) & 0xFF) +
+                                        ((c >> shift) & 0xFF) + ((d >> shift) & 0xFF);
+                    out |= ((sum + 2) >> 2) << shift;
+                }
+                dst[i] = out;
+            }
+        }
+
+        // ==================== SSE2 (4 pixels per step) ====================
+
+        __attribute__((target("sse2"))) void fillSSE2(QC::u32 *dst, QC::u32 value, QC::usize count)
+        {
+            const __m128i v = _mm_set1_epi32(static_cast<int>(value));
+            QC::usize i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), v);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + 4), v);
+            }
+            for (; i + 4 <= count; i += 4)
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), v);
+            for (; i < count; ++i)
+                dst[i] = value;
+        }
+
+        __attribute__((target("sse2"))) void copySSE2(QC::u32 *dst, const QC::u32 *src, QC::usize count)
+        {
+            QC::usize i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + 4));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), a);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + 4), b);
+            }
+            for (; i + 4 <= count; i += 4)
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i),
+                                 _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i)));
+            for (; i < count; ++i)
+                dst[i] = src[i];
+        }
+
+        // Blend two pixels held as 16-bit channels: (s * a + d * (255 - a)) / 255
+        __attribute__((target("sse2"))) inline __m128i blendHalfSSE2(__m128i s16, __m128i d16, __m128i a16)
+        {
+            const __m128i c255 = _mm_set1_epi16(255);
+            const __m128i one = _mm_set1_epi16(1);
+            const __m128i ia16 = _mm_sub_epi16(c255, a16);
+            __m128i x = _mm_add_epi16(_mm_mullo_epi16(s16, a16), _mm_mullo_epi16(d16, ia16));
+            x = _mm_add_epi16(_mm_add_epi16(x, one), _mm_srli_epi16(x, 8));
+            return _mm_srli_epi16(x, 8);
+        }
+
+        __attribute__((target("sse2"))) void blendSSE2(QC::u32 *dst, const QC::u32 *src, QC::usize count)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+
+            QC::usize i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+                const __m128i sa = _mm_and_si128(s, alphaMask);
+
+                // Opaque and fully transparent groups skip the arithmetic.
+                if (_mm_movemask_epi8(_mm_cmpeq_epi32(sa, alphaMask)) == 0xFFFF)
+                {
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), s);
+                    continue;
+                }
+                if (_mm_movemask_epi8(_mm_cmpeq_epi32(sa, zero)) == 0xFFFF)
+                    continue;
+
+                const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i));
+                const __m128i s1 = _mm_or_si128(s, alphaMask);
+
+                __m128i aLo = _mm_unpacklo_epi8(s, zero);
+                __m128i aHi = _mm_unpackhi_epi8(s, zero);
+                aLo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(aLo, 0xFF), 0xFF);
+                aHi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(aHi, 0xFF), 0xFF);
+
+                const __m128i lo = blendHalfSSE2(_mm_unpacklo_epi8(s1, zero), _mm_unpacklo_epi8(d, zero), aLo);
+                const __m128i hi = blendHalfSSE2(_mm_unpackhi_epi8(s1, zero), _mm_unpackhi_epi8(d, zero), aHi);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_packus_epi16(lo, hi));
+            }
+            for (; i < count; ++i)
+                dst[i] = blendPixel(src[i], dst[i]);
+        }
+
+        __attribute__((target("sse2"))) void blendSolidSSE2(QC::u32 *dst, QC::u32 color, QC::usize count)
+        {
+            const QC::u32 a = color >> 24;
+            if (a == 0)
+                return;
+            if (a == 255)
+            {
+                fillSSE2(dst, color, count);
+                return;
+            }
+
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i s16 = _mm_unpacklo_epi8(_mm_set1_epi32(static_cast<int>(color | 0xFF000000u)), zero);
+            const __m128i a16 = _mm_set1_epi16(static_cast<short>(a));
+
+            QC::usize i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i));
+                const __m128i lo = blendHalfSSE2(s16, _mm_unpacklo_epi8(d, zero), a16);
+                const __m128i hi = blendHalfSSE2(s16, _mm_unpackhi_epi8(d, zero), a16);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_packus_epi16(lo, hi));
+            }
+            for (; i < count; ++i)
+                dst[i] = blendPixel(color, dst[i]);
+        }
+
+        // Scale two pixels held as 16-bit channels: d * (255 - a) / 255
+        __attribute__((target("sse2"))) inline __m128i scaleHalfSSE2(__m128i d16, __m128i a16)
+        {
+            const __m128i one = _mm_set1_epi16(1);
+            __m128i x = _mm_mullo_epi16(d16, _mm_sub_epi16(_mm_set1_epi16(255), a16));
+            x = _mm_add_epi16(_mm_add_epi16(x, one), _mm_srli_epi16(x, 8));
+            return _mm_srli_epi16(x, 8);
+        }
+
+        __attribute__((target("sse2"))) void blendPremultipliedSSE2(QC::u32 *dst, const QC::u32 *src, QC::usize count)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+
+            QC::usize i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+
+                if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(s, alphaMask), alphaMask)) == 0xFFFF)
+                {
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), s);
+                    continue;
+                }
+                if (_mm_movemask_epi8(_mm_cmpeq_epi32(s, zero)) == 0xFFFF)
+                    continue;
+
+                const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i));
+
+                __m128i aLo = _mm_unpacklo_epi8(s, zero);
+                __m128i aHi = _mm_unpackhi_epi8(s, zero);
+                aLo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(aLo, 0xFF), 0xFF);
+                aHi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(aHi, 0xFF), 0xFF);
+
+                const __m128i lo = scaleHalfSSE2(_mm_unpacklo_epi8(d, zero), aLo);
+                const __m128i hi = scaleHalfSSE2(_mm_unpackhi_epi8(d, zero), aHi);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i),
+                                 _mm_adds_epu8(_mm_packus_epi16(lo, hi), s));
+            }
+            for (; i < count; ++i)
+                dst[i] = blendPremultipliedPixel(src[i], dst[i]);
+        }
+
+        // Two output pixels from four source pixels of each row, 16-bit sums.
+        __attribute__((target("sse2"))) inline __m128i downsampleQuadSSE2(const QC::u32 *row0, const QC::u32 *row1)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row0));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row1));
+            __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero)); // px 0,1
+            __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero)); // px 2,3
+            lo = _mm_add_epi16(lo, _mm_srli_si128(lo, 8));
+            hi = _mm_add_epi16(hi, _mm_srli_si128(hi, 8));
+            const __m128i sum = _mm_unpacklo_epi64(lo, hi);
+            return _mm_srli_epi16(_mm_add_epi16(sum, _mm_set1_epi16(2)), 2);
+        }
+
+        __attribute__((target("sse2"))) void downsample2xSSE2(QC::u32 *dst, const QC::u32 *row0,
+                                                              const QC::u32 *row1, QC::usize count)
+        {
+            QC::usize i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128i first = downsampleQuadSSE2(row0 + 2 * i, row1 + 2 * i);
+                const __m128i second = downsampleQuadSSE2(row0 + 2 * i + 4, row1 + 2 * i + 4);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_packus_epi16(first, second));
+            }
+            if (i < count)
+                downsample2xScalar(dst + i, row0 + 2 * i, row1 + 2 * i, count - i);
+        }
+
+        // ==================== AVX2 (8 pixels per step) ====================
+
+        __attribute__((target("avx2"))) void fillAVX2(QC::u32 *dst, QC::u32 value, QC::usize count)
+        {
+            const __m256i v = _mm256_set1_epi32(static_cast<int>(value));
+            QC::usize i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), v);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i + 8), v);
+            }
+            for (; i + 8 <= count; i += 8)
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), v);
+            for (; i < count; ++i)
+                dst[i] = value;
+        }
+
+        __attribute__((target("avx2"))) void copyAVX2(QC::u32 *dst, const QC::u32 *src, QC::usize count)
+        {
+            QC::usize i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+                const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i + 8));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), a);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i + 8), b);
+            }
+            for (; i + 8 <= count; i += 8)
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i),
+                                    _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i)));
+            for (; i < count; ++i)
+                dst[i] = src[i];
+        }
+
+        __attribute__((target("avx2"))) inline __m256i blendHalfAVX2(__m256i s16, __m256i d16, __m256i a16)
+        {
+            const __m256i c255 = _mm256_set1_epi16(255);
+            const __m256i one = _mm256_set1_epi16(1);
+            const __m256i ia16 = _mm256_sub_epi16(c255, a16);
+            __m256i x = _mm256_add_epi16(_mm256_mullo_epi16(s16, a16), _mm256_mullo_epi16(d16, ia16));
+            x = _mm256_add_epi16(_mm256_add_epi16(x, one), _mm256_srli_epi16(x, 8));
+            return _mm256_srli_epi16(x, 8);
+        }
+
+        __attribute__((target("avx2"))) void blendAVX2(QC::u32 *dst, const QC::u32 *src, QC::usize count)
+        {
+            const __m256i zero = _mm256_setzero_si256();
+            const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+
+            QC::usize i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+                const __m256i sa = _mm256_and_si256(s, alphaMask);
+
+                if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(sa, alphaMask)) == -1)
+                {
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), s);
+                    continue;
+                }
+                if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(sa, zero)) == -1)
+                    continue;
+
+                const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+                const __m256i s1 = _mm256_or_si256(s, alphaMask);
+
+                // Unpack/pack work per 128-bit lane, so pixel order is preserved.
+                __m256i aLo = _mm256_unpacklo_epi8(s, zero);
+                __m256i aHi = _mm256_unpackhi_epi8(s, zero);
+                aLo = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(aLo, 0xFF), 0xFF);
+                aHi = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(aHi, 0xFF), 0xFF);
+
+                const __m256i lo = blendHalfAVX2(_mm256_unpacklo_epi8(s1, zero), _mm256_unpacklo_epi8(d, zero), aLo);
+                const __m256i hi = blendHalfAVX2(_mm256_unpackhi_epi8(s1, zero), _mm256_unpackhi_epi8(d, zero), aHi);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_packus_epi16(lo, hi));
+            }
+            if (i < count)
+                blendSSE2(dst + i, src + i, count - i);
+        }
+
+        __attribute__((target("avx2"))) void blendSolidAVX2(QC::u32 *dst, QC::u32 color, QC::usize count)
+        {
+            const QC::u32 a = color >> 24;
+            if (a == 0)
+                return;
+            if (a == 255)
+            {
+                fillAVX2(dst, color, count);
+                return;
+            }
+
+            const __m256i zero = _mm256_setzero_si256();
+            const __m256i s16 = _mm256_unpacklo_epi8(_mm256_set1_epi32(static_cast<int>(color | 0xFF000000u)), zero);
+            const __m256i a16 = _mm256_set1_epi16(static_cast<short>(a));
+
+            QC::usize i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+                const __m256i lo = blendHalfAVX2(s16, _mm256_unpacklo_epi8(d, zero), a16);
+                const __m256i hi = blendHalfAVX2(s16, _mm256_unpackhi_epi8(d, zero), a16);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_packus_epi16(lo, hi));
+            }
+            if (i < count)
+                blendSolidSSE2(dst + i, color, count - i);
+        }
+
+        __attribute__((target("avx2"))) inline __m256i scaleHalfAVX2(__m256i d16, __m256i a16)
+        {
+            const __m256i one = _mm256_set1_epi16(1);
+            __m256i x = _mm256_mullo_epi16(d16, _mm256_sub_epi16(_mm256_set1_epi16(255), a16));
+            x = _mm256_add_epi16(_mm256_add_epi16(x, one), _mm256_srli_epi16(x, 8));
+            return _mm256_srli_epi16(x, 8);
+        }
+
+        __attribute__((target("avx2"))) void blendPremultipliedAVX2(QC::u32 *dst, const QC::u32 *src, QC::usize count)
+        {
+            const __m256i zero = _mm256_setzero_si256();
+            const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+
+            QC::usize i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+
+                if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_and_si256(s, alphaMask), alphaMask)) == -1)
+                {
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), s);
+                    continue;
+                }
+                if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(s, zero)) == -1)
+                    continue;
+
+                const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+
+                __m256i aLo = _mm256_unpacklo_epi8(s, zero);
+                __m256i aHi = _mm256_unpackhi_epi8(s, zero);
+                aLo = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(aLo, 0xFF), 0xFF);
+                aHi = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(aHi, 0xFF), 0xFF);
+
+                const __m256i lo = scaleHalfAVX2(_mm256_unpacklo_epi8(d, zero), aLo);
+                const __m256i hi = scaleHalfAVX2(_mm256_unpackhi_epi8(d, zero), aHi);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i),
+                                    _mm256_adds_epu8(_mm256_packus_epi16(lo, hi), s));
+            }
+            if (i < count)
+                blendPremultipliedSSE2(dst + i, src + i, count - i);
+        }
+
+        __attribute__((target("avx2"))) void downsample2xAVX2(QC::u32 *dst, const QC::u32 *row0,
+                                                              const QC::u32 *row1, QC::usize count)
+        {
+            const __m256i zero = _mm256_setzero_si256();
+            const __m256i two = _mm256_set1_epi16(2);
+
+            QC::usize i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row0 + 2 * i));
+                const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row1 + 2 * i));
+                // Per 128-bit lane: lo = px 0,1 (4,5), hi = px 2,3 (6,7)
+                __m256i lo = _mm256_add_epi16(_mm256_unpacklo_epi8(a, zero), _mm256_unpacklo_epi8(b, zero));
+                __m256i hi = _mm256_add_epi16(_mm256_unpackhi_epi8(a, zero), _mm256_unpackhi_epi8(b, zero));
+                lo = _mm256_add_epi16(lo, _mm256_srli_si256(lo, 8));
+                hi = _mm256_add_epi16(hi, _mm256_srli_si256(hi, 8));
+                __m256i sum = _mm256_unpacklo_epi64(lo, hi);
+                sum = _mm256_srli_epi16(_mm256_add_epi16(sum, two), 2);
+                // Packed qwords 0 and 2 hold output pixels 0,1 and 2,3.
+                const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(sum, sum), 0x08);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm256_castsi256_si128(packed));
+            }
+            if (i < count)
+                downsample2xScalar(dst + i, row0 + 2 * i, row1 + 2 * i, count - i);
+        }
+
+        // ==================== Gradient ====================
+
+        // Walks start + round(diff * step / segments) one step at a time without
+        // dividing per pixel; matches the rounding of PixelKernels::gradientColor.
+        struct GradientChannel
+        {
+            QC::i32 start;
+            QC::i32 sign;
+            QC::u32 quotient;
+            QC::u32 remainder;
+            QC::u32 stepQuotient;
+            QC::u32 stepRemainder;
+            QC::u32 segments;
+
+            void init(QC::u8 from, QC::u8 to, QC::i32 step, QC::i32 segs)
+            {
+                const QC::i32 diff = static_cast<QC::i32>(to) - static_cast<QC::i32>(from);
+                const QC::u32 magnitude = static_cast<QC::u32>(diff < 0 ? -diff : diff);
+                start = from;
+                sign = diff < 0 ? -1 : 1;
+                segments = static_cast<QC::u32>(segs);
+
+                const QC::u64 numerator = static_cast<QC::u64>(magnitude) * static_cast<QC::u64>(step) + segments / 2;
+                quotient = static_cast<QC::u32>(numerator / segments);
+                remainder = static_cast<QC::u32>(numerator % segments);
+                stepQuotient = magnitude / segments;
+                stepRemainder = magnitude % segments;
+            }
+
+            QC::u32 value() const
+            {
+                QC::i32 v = start + sign * static_cast<QC::i32>(quotient);
+                if (v < 0)
+                    v = 0;
+                else if (v > 255)
+                    v = 255;
+                return static_cast<QC::u32>(v);
+            }
+
+            void advance()
+            {
+                quotient += stepQuotient;
+                remainder += stepRemainder;
+                if (remainder >= segments)
+                {
+                    remainder -= segments;
+                    ++quotient;
+                }
+            }
+        };
+    } // namespace
+
+    PixelKernels &PixelKernels::instance()
+    {
+        static PixelKernels kernels;
+        return kernels;
+    }
+
+    PixelKernels::PixelKernels()
+        : m_fill(fillScalar),
+          m_copy(copyScalar),
+          m_blend(blendScalar),
+          m_blendSolid(blendSolidScalar),
+          m_blendPremultiplied(blendPremultipliedScalar),
+          m_downsample2x(downsample2xScalar),
+          m_isa(PixelIsa::Scalar)
+    {
+        select();
+    }
+
+    void PixelKernels::select()
+    {
+        auto &cpu = QArch::CPU::instance();
+        const QArch::CPUFeatures &features = cpu.features();
+
+        if (features.avx2 && cpu.avxStateEnabled())
+        {
+            m_fill = fillAVX2;
+            m_copy = copyAVX2;
+            m_blend = blendAVX2;
+            m_blendSolid = blendSolidAVX2;
+            m_blendPremultiplied = blendPremultipliedAVX2;
+            m_downsample2x = downsample2xAVX2;
+            m_isa = PixelIsa::AVX2;
+        }
+        else if (features.sse2)
+        {
+            m_fill = fillSSE2;
+            m_copy = copySSE2;
+            m_blend = blendSSE2;
+            m_blendSolid = blendSolidSSE2;
+            m_blendPremultiplied = blendPremultipliedSSE2;
+            m_downsample2x = downsample2xSSE2;
+            m_isa = PixelIsa::SSE2;
+        }
+        else
+        {
+            m_fill = fillScalar;
+            m_copy = copyScalar;
+            m_blend = blendScalar;
+            m_blendSolid = blendSolidScalar;
+            m_blendPremultiplied = blendPremultipliedScalar;
+            m_downsample2x = downsample2xScalar;
+            m_isa = PixelIsa::Scalar;
+        }
+    }
+
+    const char *PixelKernels::isaName() const
+    {
+        switch (m_isa)
+        {
+        case PixelIsa::AVX2:
+            return "AVX2";
+        case PixelIsa::SSE2:
+            return "SSE2";
+        case PixelIsa::Scalar:
+            break;
+        }
+        return "scalar";
+    }
+
+    void PixelKernels::gradient(QC::u32 *dst, QC::Color from, QC::Color to,
+                                QC::i32 startStep, QC::i32 segments, QC::usize count) const
+    {
+        if (segments <= 0)
+        {
+            m_fill(dst, from.value, count);
+            return;
+        }
+
+        GradientChannel r, g, b, a;
+        r.init(from.r, to.r, startStep, segments);
+        g.init(from.g, to.g, startStep, segments);
+        b.init(from.b, to.b, startStep, segments);
+        a.init(from.a, to.a, startStep, segments);
+
+        for (QC::usize i = 0; i < count; ++i)
+        {
+            dst[i] = (a.value() << 24) | (r.value() << 16) | (g.value() << 8) | b.value();
+            r.advance();
+            g.advance();
+            b.advance();
+            a.advance();
+        }
+    }
+
+    void PixelKernels::fillRect(QC::u32 *pixels, QC::usize pitch, const QC::Rect &rect, QC::u32 value) const
+    {
+        QC::u32 *row = pixels + static_cast<QC::usize>(rect.y) * pitch + rect.x;
+        for (QC::u32 y = 0; y < rect.height; ++y, row += pitch)
+        {
+            m_fill(row, value, rect.width);
+        }
+    }
+
+    void PixelKernels::moveRect(QC::u32 *pixels, QC::usize pitch, const QC::Rect &rect,
+                                QC::i32 dx, QC::i32 dy) const
+    {
+        const QC::Rect dst = rect.intersection(rect.offset(dx, dy));
+        if (dst.isEmpty() || (dx == 0 && dy == 0))
+            return;
+
+        const QC::usize width = dst.width;
+        const QC::i32 srcX = dst.x - dx;
+
+        // Walk rows against the direction of travel so every source row is
+        // read before it is overwritten: bottom-up when moving down.
+        const bool movingDown = dy > 0;
+        for (QC::u32 i = 0; i < dst.height; ++i)
+        {
+            const QC::i32 y = movingDown ? dst.bottom() - 1 - static_cast<QC::i32>(i) : dst.y + static_cast<QC::i32>(i);
+            QC::u32 *to = pixels + static_cast<QC::usize>(y) * pitch + dst.x;
+            const QC::u32 *from = pixels + static_cast<QC::usize>(y - dy) * pitch + srcX;
+
+            // Rows only alias each other on a horizontal move.
+            if (dy == 0)
+                memmove(to, from, width * sizeof(QC::u32));
+            else
+                m_copy(to, from, width);
+        }
+    }
+
+    QC::Color PixelKernels::gradientColor(QC::Color from, QC::Color to, QC::i32 step, QC::i32 segments)
+    {
+        if (segments <= 0)
+            return from;
+
+        auto channel = [step, segments](QC::u8 start, QC::u8 end) -> QC::u8
+        {
+            QC::i32 diff = static_cast<QC::i32>(end) - static_cast<QC::i32>(start);
+            QC::i64 scaled = static_cast<QC::i64>(diff) * static_cast<QC::i64>(step);
+
+            QC::i64 roundTerm = segments / 2;
+            if (scaled < 0)
+                scaled -= roundTerm;
+            else
+                scaled += roundTerm;
+
+            QC::i32 value = static_cast<QC::i32>(start) + static_cast<QC::i32>(scaled / segments);
+            if (value < 0)
+                value = 0;
+            else if (value > 255)
+                value = 255;
+
+            return static_cast<QC::u8>(value);
+        };
+
+        return QC::Color(channel(from.r, to.r),
+                         channel(from.g, to.g),
+                         channel(from.b, to.b),
+                         channel(from.a, to.a));
+    }
+
+    void PixelKernels::premultiply(QC::u32 *pixels, QC::usize count)
+    {
+        for (QC::usize i = 0; i < count; ++i)
+        {
+            const QC::u32 p = pixels[i];
+            const QC::u32 a = p >> 24;
+            if (a == 255)
+                continue;
+
+            pixels[i] = (a << 24) |
+                        (div255(((p >> 16) & 0xFF) * a) << 16) |
+                        (div255(((p >> 8) & 0xFF) * a) << 8) |
+                        div255((p & 0xFF) * a);
+        }
+    }
+
+} // namespace QG
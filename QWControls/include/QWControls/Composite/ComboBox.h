@@ -123,6 +123,7 @@ namespace QW
             // ==================== Rendering ====================
 
             void paint(const PaintContext &context) override;
+            Rect paintBounds() const override;
 
             // ==================== Event Handlers ====================
 
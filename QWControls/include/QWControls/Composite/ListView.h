@@ -120,6 +120,11 @@ namespace QW
         private:
             QC::isize itemAtPoint(QC::i32 x, QC::i32 y);
             QC::usize visibleItemCount() const;
+            /// Window-local Y of the first item row
+            QC::i32 rowsTop() const;
+            /// Move the view to `offset`, blitting the rows that stay visible
+            void scrollTo(QC::usize offset);
+            void invalidateRows(QC::usize first, QC::usize count);
 
             QC::Vector<ListViewColumn> m_columns;
             QC::Vector<ListViewItem> m_items;
@@ -2,7 +2,6 @@
 
 #include "QWControls/Base/ControlBase.h"
 #include "QG/Image.h"
-#include "QCVector.h"
 
 namespace QW
 {
@@ -29,7 +28,7 @@ namespace QW
         private:
             const QG::ImageSurface *m_surface;
             QG::ImageScaleMode m_scaleMode;
-            QC::Vector<QC::u32> m_scratchRow;
+            QG::ScaledImage m_scaled;
         };
     }
 } // namespace QW
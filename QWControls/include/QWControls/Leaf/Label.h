@@ -40,6 +40,10 @@ namespace QW
             const char *text() const { return m_text; }
             void setText(const char *text);
 
+            /// Append `line` plus a newline. In follow-tail mode the painted lines
+            /// scroll up with a surface blit and only the new line is repainted.
+            void appendLine(const char *line);
+
             // Alignment
             TextAlign textAlign() const { return m_textAlign; }
             void setTextAlign(TextAlign align) { m_textAlign = align; }
@@ -61,6 +65,10 @@ namespace QW
             bool transparent() const { return m_transparent; }
             void setTransparent(bool transparent) { m_transparent = transparent; }
 
+            // Follow tail: show the last lines that fit, top-aligned (log/terminal output)
+            bool followTail() const { return m_followTail; }
+            void setFollowTail(bool follow);
+
             // Labels are non-interactive by default; they should not intercept mouse hit tests.
             bool hitTest(int, int) const override { return false; }
 
@@ -68,12 +76,20 @@ namespace QW
             void paint(const PaintContext &context) override;
 
         private:
+            /// Number of lines in the text (a trailing newline does not start a new line)
+            QC::usize lineCount() const;
+            /// Lines that fit in the bounds at the last painted line height
+            QC::usize visibleLineCount() const;
+
             char *m_text;
+            QC::usize m_textLength;
 
             TextAlign m_textAlign;
             VerticalAlign m_verticalAlign;
             bool m_wordWrap;
             bool m_transparent;
+            bool m_followTail;
+            QC::u32 m_lineHeight; // Cached from the painter; 0 until first paint
 
             Color m_textColor;
             Color m_bgColor;
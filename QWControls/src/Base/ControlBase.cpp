@@ -127,7 +127,7 @@ namespace QW
         void ControlBase::invalidate()
         {
             if (m_window)
-                m_window->invalidateRect(absoluteBounds());
+                m_window->invalidateRect(paintBounds());
         }
 
         // ----------------------------
@@ -326,6 +326,8 @@ namespace QW
         {
             if (m_droppedDown)
             {
+                // Repaint the area the dropdown covered while it is still included.
+                invalidate();
                 m_droppedDown = false;
                 if (m_dropdownPanel)
                 {
@@ -365,6 +367,16 @@ namespace QW
             }
         }
 
+        Rect ComboBox::paintBounds() const
+        {
+            Rect area = absoluteBounds();
+            if (m_droppedDown && m_dropdownPanel)
+            {
+                area = area.united(m_dropdownPanel->absoluteBounds());
+            }
+            return area;
+        }
+
         bool ComboBox::onMouseDown(QC::i32 x, QC::i32 y, QK::Event::MouseButton button)
         {
             if (!m_enabled || button != QK::Event::MouseButton::Left)
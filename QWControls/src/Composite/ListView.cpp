@@ -224,7 +224,7 @@ namespace QW
         {
             if (offset < m_items.size())
             {
-                m_scrollOffset = offset;
+                scrollTo(offset);
             }
         }
 
@@ -236,11 +236,11 @@ namespace QW
             QC::usize visible = visibleItemCount();
             if (index < m_scrollOffset)
             {
-                m_scrollOffset = index;
+                scrollTo(index);
             }
             else if (index >= m_scrollOffset + visible)
             {
-                m_scrollOffset = index - visible + 1;
+                scrollTo(index - visible + 1);
             }
         }
 
@@ -268,8 +268,10 @@ namespace QW
             painter->drawRect(abs, Color(128, 128, 128, 255));
 
             QC::i32 currentY = abs.y;
+            const Rect clip = painter->clipRect();
 
-            if (m_showHeader && m_columns.size() > 0)
+            if (m_showHeader && m_columns.size() > 0 &&
+                clip.intersects(Rect{abs.x, currentY, abs.width, m_itemHeight}))
             {
                 Rect headerRect = {abs.x, currentY, abs.width, m_itemHeight};
                 painter->fillRect(headerRect, m_headerColor);
@@ -283,8 +285,8 @@ namespace QW
                                       m_textColor);
                     colX += static_cast<QC::i32>(m_columns[i].width);
                 }
-                currentY += static_cast<QC::i32>(m_itemHeight);
             }
+            currentY = rowsTop();
 
             QC::usize visible = visibleItemCount();
             for (QC::usize i = 0; i < visible && (m_scrollOffset + i) < m_items.size(); ++i)
@@ -293,6 +295,11 @@ namespace QW
                 const ListViewItem &item = m_items[itemIndex];
 
                 Rect itemRect = {abs.x, currentY, abs.width, m_itemHeight};
+                if (!clip.intersects(itemRect))
+                {
+                    currentY += static_cast<QC::i32>(m_itemHeight);
+                    continue;
+                }
 
                 if (item.selected)
                 {
@@ -361,14 +368,12 @@ namespace QW
         {
             if (delta > 0 && m_scrollOffset > 0)
             {
-                m_scrollOffset--;
-                invalidate();
+                scrollTo(m_scrollOffset - 1);
                 return true;
             }
             else if (delta < 0 && m_scrollOffset + visibleItemCount() < m_items.size())
             {
-                m_scrollOffset++;
-                invalidate();
+                scrollTo(m_scrollOffset + 1);
                 return true;
             }
             return false;
@@ -407,6 +412,58 @@ namespace QW
             return -1;
         }
 
+        QC::i32 ListView::rowsTop() const
+        {
+            QC::i32 top = absoluteBounds().y;
+            if (m_showHeader && m_columns.size() > 0)
+                top += static_cast<QC::i32>(m_itemHeight);
+            return top;
+        }
+
+        void ListView::scrollTo(QC::usize offset)
+        {
+            if (offset == m_scrollOffset)
+                return;
+
+            const QC::usize old = m_scrollOffset;
+            m_scrollOffset = offset;
+
+            const QC::usize visible = visibleItemCount();
+            const QC::usize distance = offset > old ? offset - old : old - offset;
+            if (!m_window || !m_visible || visible == 0 || distance >= visible)
+            {
+                invalidate();
+                return;
+            }
+
+            // Rows are a pure function of their item, so the rows that stay on
+            // screen can be moved as pixels; only the uncovered rows repaint.
+            const Rect abs = absoluteBounds();
+            const Rect rows{abs.x, rowsTop(), abs.width, static_cast<QC::u32>(visible * m_itemHeight)};
+            const QC::i32 dy = (static_cast<QC::i32>(old) - static_cast<QC::i32>(offset)) *
+                               static_cast<QC::i32>(m_itemHeight);
+            m_window->scrollRect(rows, 0, dy);
+
+            // Unselected rows show the frame through them where they touch it,
+            // so edge rows are repainted rather than trusted to the blit.
+            if (rows.y == abs.y)
+                invalidateRows(0, 1);
+            if (rows.bottom() >= abs.bottom() - 1)
+                invalidateRows(visible - 1, 1);
+        }
+
+        void ListView::invalidateRows(QC::usize first, QC::usize count)
+        {
+            if (!m_window || count == 0)
+                return;
+
+            const Rect abs = absoluteBounds();
+            m_window->invalidateRect(Rect{abs.x,
+                                          rowsTop() + static_cast<QC::i32>(first * m_itemHeight),
+                                          abs.width,
+                                          static_cast<QC::u32>(count * m_itemHeight)});
+        }
+
         QC::usize ListView::visibleItemCount() const
         {
             QC::u32 headerHeight = m_showHeader ? m_itemHeight : 0;
@@ -185,9 +185,12 @@ namespace QW
 
         void Container::paintChildren(const PaintContext &context)
         {
+            // Children outside the painter clip (the window's dirty area) are skipped.
+            const Rect clip = context.painter ? context.painter->clipRect() : Rect{};
             for (QC::usize i = 0; i < m_children.size(); ++i)
             {
-                if (m_children[i]->isVisible())
+                if (m_children[i]->isVisible() &&
+                    (!context.painter || m_children[i]->paintBounds().intersects(clip)))
                 {
                     m_children[i]->paint(context);
                 }
@@ -22,7 +22,10 @@ namespace QW
 
         void ImageView::setImage(const QG::ImageSurface *surface)
         {
+            if (m_surface == surface)
+                return;
             m_surface = surface;
+            m_scaled.reset();
             invalidate();
         }
 
@@ -40,7 +43,7 @@ namespace QW
                 return;
 
             QC::Rect rect = absoluteBounds();
-            QG::blitImage(context.painter, *m_surface, rect, m_scaleMode, m_scratchRow);
+            QG::blitImage(context.painter, *m_surface, rect, m_scaleMode, m_scaled);
         }
 
     } // namespace Controls
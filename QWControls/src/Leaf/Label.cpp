@@ -16,10 +16,13 @@ namespace QW
         Label::Label()
             : ControlBase(),
               m_text(nullptr),
+              m_textLength(0),
               m_textAlign(TextAlign::Left),
               m_verticalAlign(VerticalAlign::Top),
               m_wordWrap(false),
               m_transparent(true),
+              m_followTail(false),
+              m_lineHeight(0),
               m_textColor(Color(0, 0, 0, 255))
         {
             m_bgColor = Color(255, 255, 255, 255);
@@ -28,10 +31,13 @@ namespace QW
         Label::Label(Window *window, const char *text, Rect bounds)
             : ControlBase(window, bounds),
               m_text(nullptr),
+              m_textLength(0),
               m_textAlign(TextAlign::Left),
               m_verticalAlign(VerticalAlign::Top),
               m_wordWrap(false),
               m_transparent(false),
+              m_followTail(false),
+              m_lineHeight(0),
               m_textColor(Color(0, 0, 0, 255))
         {
             m_bgColor = Color(255, 255, 255, 255);
@@ -54,6 +60,7 @@ namespace QW
                 QK::Memory::Heap::instance().free(m_text);
                 m_text = nullptr;
             }
+            m_textLength = 0;
 
             if (text)
             {
@@ -62,12 +69,96 @@ namespace QW
                 if (m_text)
                 {
                     strcpy(m_text, text);
+                    m_textLength = len;
                 }
             }
 
             invalidate();
         }
 
+        void Label::appendLine(const char *line)
+        {
+            if (!line)
+                return;
+
+            const QC::usize oldLines = lineCount();
+            const QC::usize addLen = strlen(line);
+            char *text = static_cast<char *>(QK::Memory::Heap::instance().allocate(m_textLength + addLen + 2));
+            if (!text)
+                return;
+
+            if (m_text)
+            {
+                memcpy(text, m_text, m_textLength);
+                QK::Memory::Heap::instance().free(m_text);
+            }
+            memcpy(text + m_textLength, line, addLen);
+            m_textLength += addLen;
+            text[m_textLength++] = '\n';
+            text[m_textLength] = '\0';
+            m_text = text;
+
+            const QC::usize visible = visibleLineCount();
+            if (!m_followTail || !m_window || !m_visible || m_transparent || visible == 0)
+            {
+                invalidate();
+                return;
+            }
+
+            const QC::usize newLines = lineCount();
+            const Rect abs = absoluteBounds();
+            const QC::i32 lh = static_cast<QC::i32>(m_lineHeight);
+
+            if (newLines <= visible)
+            {
+                // Still filling the box: only the new rows change.
+                m_window->invalidateRect(Rect{abs.x, abs.y + static_cast<QC::i32>(oldLines) * lh, abs.width,
+                                              static_cast<QC::u32>((newLines - oldLines) * m_lineHeight)});
+                return;
+            }
+
+            const QC::usize added = newLines - oldLines;
+            if (oldLines < visible || added >= visible)
+            {
+                invalidate();
+                return;
+            }
+
+            // The box was full: move the kept lines up and paint the new ones.
+            const Rect block{abs.x, abs.y, abs.width, static_cast<QC::u32>(visible * m_lineHeight)};
+            m_window->scrollRect(block, 0, -static_cast<QC::i32>(added) * lh);
+        }
+
+        void Label::setFollowTail(bool follow)
+        {
+            if (m_followTail == follow)
+                return;
+
+            m_followTail = follow;
+            invalidate();
+        }
+
+        QC::usize Label::lineCount() const
+        {
+            if (!m_text || m_textLength == 0)
+                return 0;
+
+            QC::usize lines = 0;
+            for (QC::usize i = 0; i < m_textLength; ++i)
+            {
+                if (m_text[i] == '\n')
+                    ++lines;
+            }
+            if (m_text[m_textLength - 1] != '\n')
+                ++lines;
+            return lines;
+        }
+
+        QC::usize Label::visibleLineCount() const
+        {
+            return m_lineHeight ? m_bounds.height / m_lineHeight : 0;
+        }
+
         void Label::paint(const PaintContext &context)
         {
             if (!m_visible || !context.painter)
@@ -84,6 +175,41 @@ namespace QW
             if (!m_text)
                 return;
 
+            m_lineHeight = static_cast<QC::u32>(painter->measureText("M").height);
+
+            if (m_followTail)
+            {
+                // Skip the lines scrolled off the top and those above the clip;
+                // the painter clips whatever falls below it.
+                const QC::usize lines = lineCount();
+                const QC::usize visible = visibleLineCount();
+                QC::usize first = lines > visible ? lines - visible : 0;
+
+                const Rect clip = painter->clipRect();
+                if (m_lineHeight > 0 && clip.y > abs.y)
+                {
+                    const QC::usize clipFirst = first + static_cast<QC::usize>(clip.y - abs.y) / m_lineHeight;
+                    if (clipFirst > first)
+                        first = clipFirst;
+                }
+                if (first >= lines)
+                    return;
+
+                const char *p = m_text;
+                for (QC::usize skipped = 0; skipped < first && *p; ++p)
+                {
+                    if (*p == '\n')
+                        ++skipped;
+                }
+
+                const QC::usize firstVisible = lines > visible ? lines - visible : 0;
+                painter->drawText(abs.x,
+                                  abs.y + static_cast<QC::i32>((first - firstVisible) * m_lineHeight),
+                                  p,
+                                  m_textColor);
+                return;
+            }
+
             QC::i32 textX = abs.x;
             QC::i32 textY = abs.y;
 
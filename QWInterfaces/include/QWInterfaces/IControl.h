@@ -67,6 +67,9 @@ namespace QW
             virtual Rect absoluteBounds() const = 0;
             virtual bool hitTest(int x, int y) const = 0;
 
+            /// Window-space area the control may paint into (popups may extend past bounds)
+            virtual Rect paintBounds() const { return absoluteBounds(); }
+
             // State
             virtual bool isEnabled() const = 0;
             virtual void setEnabled(bool enabled) = 0;
@@ -0,0 +1,46 @@
+#pragma once
+
+// QWindowing BGA Flip Present Backend - page flipping through the BGA virtual screen
+// Namespace: QW
+
+#include "QWPresentBackend.h"
+
+namespace QW
+{
+    class Framebuffer;
+
+    /// Two-page flip chain in VRAM: the compositor renders straight into the
+    /// hidden page and present() flips the scanout Y offset to it. Nothing is
+    /// copied; instead the damage of the last frame is carried over so the
+    /// next target page catches up on what it missed.
+    class BGAFlipPresentBackend final : public PresentBackend
+    {
+    public:
+        /// Rects remembered per frame before falling back to a full repaint
+        static constexpr QC::usize MaxStaleRects = 32;
+
+        void initialize(Framebuffer *fb) override;
+        void present() override;
+        void present(const QC::Rect *dirtyRects, QC::usize dirtyCount) override;
+
+        QC::u32 *acquireRenderTarget(QC::u32 &pitchBytes) override;
+        QC::usize staleRects(QC::Rect *out, QC::usize maxRects) const override;
+
+        /// True once the virtual screen holds two pages and both are mapped
+        bool isActive() const { return m_active; }
+
+    private:
+        Framebuffer *m_framebuffer = nullptr;
+        bool m_active = false;
+
+        QC::u32 *m_pages[2] = {nullptr, nullptr};
+        QC::u32 m_pitch = 0;
+        QC::u32 m_back = 1;
+
+        // Damage the current back page has not seen yet (the previous frame's).
+        QC::Rect m_stale[MaxStaleRects];
+        QC::usize m_staleCount = 0;
+        // Frames that still need a full repaint (both pages start undefined).
+        QC::u32 m_fullFramesPending = 2;
+    };
+}
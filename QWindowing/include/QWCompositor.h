@@ -6,6 +6,7 @@
 #include "QCTypes.h"
 #include "QCVector.h"
 #include "QWWindowManager.h"
+#include "QWTileGrid.h"
 
 namespace QW
 {
@@ -14,6 +15,7 @@ namespace QW
     class Framebuffer;
     class Renderer;
     class PresentBackend;
+    class PerfHud;
 
     // Composition effect
     enum class CompositionEffect : QC::u8
@@ -24,16 +26,15 @@ namespace QW
         Transparency
     };
 
-    // Dirty region
-    struct DirtyRegion
-    {
-        Rect rect;
-        bool merged;
-    };
-
     class Compositor
     {
     public:
+        /// Rects handed to the present backend per frame; the damaged tiles
+        /// are grouped into at most this many
+        static constexpr QC::usize MaxPresentRects = 32;
+        /// Rects of missed damage taken from a flip chain per frame
+        static constexpr QC::usize MaxStaleRects = 32;
+
         Compositor(Framebuffer *fb);
         ~Compositor();
 
@@ -41,9 +42,9 @@ namespace QW
 
         // Composition
         void compose();
-        void composeWindow(Window *window);
+        void composeWindow(Renderer &renderer, Window *window);
 
-        // Dirty regions
+        // Damage (tracked per screen tile)
         void invalidate(const Rect &rect);
         void invalidateAll();
         void clearDirtyRegions();
@@ -53,35 +54,82 @@ namespace QW
         bool hasEffect(CompositionEffect effect) const;
 
         // Window decorations
-        void drawWindowDecorations(Window *window);
+        void drawWindowDecorations(Renderer &renderer, Window *window);
         void drawTitleBar(Window *window);
-        void drawBorder(Window *window);
+        void drawBorder(Renderer &renderer, Window *window);
         void drawShadow(Window *window);
 
         // Desktop
         void setWallpaper(const QC::u32 *pixels, QC::u32 width, QC::u32 height);
-        void drawDesktop();
+        void drawDesktop(Renderer &renderer);
 
         // Cursor
         void setCursor(const QC::u32 *pixels, QC::u32 width, QC::u32 height,
                        QC::i32 hotspotX, QC::i32 hotspotY);
         void syncHardwareCursorPosition();
-        void drawCursor(QC::i32 x, QC::i32 y);
+        void drawCursor(Renderer &renderer, QC::i32 x, QC::i32 y);
         void saveCursorBackground(QC::i32 x, QC::i32 y);
         void restoreCursorBackground();
 
+        // Performance HUD (drawn above windows, below the cursor)
+        void setHudVisible(bool visible);
+        bool isHudVisible() const;
+        void toggleHud() { setHudVisible(!isHudVisible()); }
+
         // Performance
+        /// TSC cycles spent in the last compose(), present included
         QC::u64 lastComposeTime() const { return m_lastComposeTime; }
         QC::u32 frameCount() const { return m_frameCount; }
 
     private:
-        void mergeDirtyRegions();
+        /// One dirty tile's work: the windows over it, top to bottom, in
+        /// m_tileWindows[first, first + count)
+        struct TileJob
+        {
+            QC::u32 tile;
+            QC::u32 first;
+            QC::u32 count;
+            bool background; // No opaque window covers the whole tile
+        };
+
+        /// A visible window and its bounds, gathered once per frame
+        struct StackEntry
+        {
+            Window *window;
+            Rect bounds;
+            bool opaque;
+        };
+
+        void addDamage(const Rect &rect);
+        /// Re-cut the tile grid if the screen size changed (damages everything)
+        void syncTileGrid();
+        /// Build m_tileJobs and m_tileWindows for the dirty tiles
+        void buildTileJobs();
+        /// Compose m_tileJobs[begin, end) with `renderer`. Only reads the state
+        /// buildTileJobs() prepared and tiles never overlap, so disjoint ranges
+        /// can run on separate CPUs, each with its own Renderer copy.
+        void composeTiles(Renderer &renderer, QC::usize begin, QC::usize end);
+        void composeTile(Renderer &renderer, const TileJob &job);
+        void trackSoftwareCursor();
+        /// Cursor overlay: when only the pointer moved, restore the saved pixels,
+        /// re-blend at the new spot and present just the two cursor rects.
+        /// Returns false when a regular compose is needed.
+        bool moveSoftwareCursor();
+        /// Hand the frame's dirty rects to the present backend (timed as the Present stage)
+        void presentRects(const QC::Rect *rects, QC::usize count);
 
         Framebuffer *m_framebuffer;
         Renderer *m_renderer;
         PresentBackend *m_presentBackend;
+        PerfHud *m_hud;
+
+        TileGrid m_tiles; // Damage since the last frame
 
-        QC::Vector<DirtyRegion> m_dirtyRegions;
+        // Per-frame composition state (kept as members to reuse their storage)
+        QC::Vector<StackEntry> m_stack;        // Visible windows, top to bottom
+        QC::Vector<TileJob> m_tileJobs;        // Dirty tiles in screen order
+        QC::Vector<Window *> m_tileWindows;    // Per-tile window lists
+        QC::Vector<QC::Rect> m_presentRects;
         QC::u32 m_effects;
 
         // Wallpaper
@@ -98,6 +146,9 @@ namespace QW
         QC::u32 *m_cursorBackground;
         QC::i32 m_cursorBackX;
         QC::i32 m_cursorBackY;
+        Rect m_cursorRect; // Where the software cursor was last composed
+        bool m_cursorDrawn;
+        bool m_cursorBackValid; // m_cursorBackground holds the scene under m_cursorRect
 
         // Stats
         QC::u64 m_lastComposeTime;
@@ -0,0 +1,94 @@
+#pragma once
+
+// QWindowing Frame Scheduler - frame pacing and per-stage frame timing
+// Namespace: QW
+
+#include "QCTypes.h"
+
+namespace QW
+{
+
+    /// Values recorded per frame, in TSC cycles
+    enum class FrameMetric : QC::u8
+    {
+        Events,       // Driver poll + event dispatch since the previous frame
+        Paint,        // Deferred window painting
+        Compose,      // Damage recomposition
+        Present,      // Present backend / framebuffer copy
+        Total,        // All of the above
+        InputLatency, // Oldest input event of the frame to present done (0: no input)
+        Count
+    };
+
+    /// Paces the desktop loop to a target frame interval and keeps a ring of
+    /// recent frame timings. Invalidations arriving between two frame slots
+    /// accumulate in the window manager's dirty state and render together.
+    class FrameScheduler
+    {
+    public:
+        /// Frames kept for percentiles
+        static constexpr QC::usize HistorySize = 128;
+
+        static FrameScheduler &instance();
+
+        /// Set up pacing; a zero TSC frequency disables it (render whenever dirty)
+        void initialize(QC::u64 tscFrequency, QC::u32 targetHz);
+        void setTargetRate(QC::u32 hz);
+        QC::u32 targetRate() const { return m_targetHz; }
+        QC::u64 frameInterval() const { return m_interval; }
+        QC::u64 tscFrequency() const { return m_tscFrequency; }
+
+        /// True once the next frame slot has opened
+        bool frameDue(QC::u64 now) const { return m_interval == 0 || now >= m_nextFrame; }
+        QC::u64 nextFrameTime() const { return m_nextFrame; }
+
+        // Instrumentation
+        void beginFrame(QC::u64 now);
+        /// Add cycles to a stage of the frame being built (may be called between frames)
+        void addTime(FrameMetric stage, QC::u64 cycles);
+        /// Report the timestamp of an input event dispatched for the coming frame
+        void noteInput(QC::u64 timestamp);
+        void endFrame(QC::u64 now);
+
+        /// Percentile (0-100) of a metric over the recorded history
+        QC::u64 percentile(FrameMetric metric, QC::u32 pct) const;
+        QC::usize sampleCount() const { return m_count; }
+        QC::u32 frameCount() const { return m_frameCount; }
+        /// Frames that finished after their slot had already passed
+        QC::u32 missedFrames() const { return m_missedFrames; }
+        /// Most recent frame's value (0 before the first frame)
+        QC::u64 lastValue(FrameMetric metric) const { return recentValue(metric, 0); }
+        /// Value recorded `age` frames ago (0: most recent; 0 past the history)
+        QC::u64 recentValue(FrameMetric metric, QC::usize age) const;
+
+    private:
+        FrameScheduler() = default;
+        FrameScheduler(const FrameScheduler &) = delete;
+        FrameScheduler &operator=(const FrameScheduler &) = delete;
+
+        static constexpr QC::usize MetricCount = static_cast<QC::usize>(FrameMetric::Count);
+
+        struct FrameSample
+        {
+            QC::u64 values[MetricCount];
+        };
+
+        void logSummary() const;
+
+        QC::u64 m_tscFrequency = 0;
+        QC::u32 m_targetHz = 0;
+        QC::u64 m_interval = 0;
+        QC::u64 m_nextFrame = 0;
+
+        FrameSample m_current{};
+        QC::u64 m_frameStart = 0;
+        QC::u64 m_oldestInput = 0;
+
+        FrameSample m_history[HistorySize]{};
+        QC::usize m_head = 0; // Next slot to write
+        QC::usize m_count = 0;
+        QC::u32 m_frameCount = 0;
+        QC::u32 m_missedFrames = 0;
+    };
+
+} // namespace QW
@@ -37,6 +37,7 @@ namespace QW
         QC::u32 pitch() const { return m_pitch; }
         QC::u32 bpp() const { return m_bpp; }
         PixelFormat format() const { return m_format; }
+        QC::uptr physicalAddress() const { return m_physicalAddress; }
 
         // Buffer access
         void *buffer() const { return m_buffer; }
@@ -45,6 +46,8 @@ namespace QW
         // Double buffering
         void *backBuffer() const { return m_backBuffer; }
         void swap();
+        /// Copy only the given back-buffer rects to the front buffer (count 0: whole frame)
+        void swap(const QC::Rect *rects, QC::usize count);
         void setVSync(bool enabled) { m_vsync = enabled; }
 
         // Pixel operations
@@ -4,6 +4,7 @@
 // Namespace: QW
 
 #include "QGGraphicsBackend.h"
+#include "QG/NinePatch.h"
 #include "QWFramebuffer.h"
 #include "QWRenderer.h"
 
@@ -46,11 +47,13 @@ namespace QW
                   const QC::u32 *pixels,
                   QC::u32 stride,
                   bool useAlpha) override;
+        bool scrollRect(const QC::Rect &rect, QC::i32 dx, QC::i32 dy) override;
 
     private:
         bool updateTarget();
         bool clipRect(const QC::Rect &rect, QC::Rect &clipped) const;
         void fillRectAlpha(const QC::Rect &rect, QC::Color color);
+        void drawNinePatch(const QG::NinePatch &patch, const QC::Rect &rect);
         static QG::PixelFormat convertFormat(PixelFormat format);
 
         Framebuffer *m_framebuffer;
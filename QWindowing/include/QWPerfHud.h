@@ -0,0 +1,58 @@
+#pragma once
+
+// QWindowing Performance HUD - on-screen frame statistics overlay
+// Namespace: QW
+
+#include "QCTypes.h"
+#include "QWWindowManager.h"
+#include "QG/PainterSurface.h"
+
+namespace QW
+{
+
+    /// Opaque statistics panel in the top-right corner. The compositor
+    /// treats it like a topmost opaque window: its rect joins the frame's
+    /// damage, hides the scene beneath it and is drawn before the cursor.
+    /// It only refreshes on frames that are composed anyway, so it never
+    /// causes a frame of its own.
+    class PerfHud
+    {
+    public:
+        static constexpr QC::u32 Width = 168;
+        static constexpr QC::u32 Height = 112;
+
+        PerfHud();
+        ~PerfHud();
+
+        PerfHud(const PerfHud &) = delete;
+        PerfHud &operator=(const PerfHud &) = delete;
+
+        bool isVisible() const { return m_visible && m_pixels; }
+        void setVisible(bool visible) { m_visible = visible; }
+
+        /// Place the panel for the given screen size
+        void setScreenSize(QC::u32 width, QC::u32 height);
+        Rect rect() const { return m_rect; }
+
+        /// Redraw the panel from this frame's compositor figures and the
+        /// global counters (heap, PMM, event queue, frame history)
+        void update(QC::u64 damagedPixels, bool fullPresent, QC::u32 frameCount);
+
+        const QC::u32 *pixels() const { return m_pixels; }
+        QC::u32 pitch() const { return Width * sizeof(QC::u32); }
+
+    private:
+        void drawGraph(const Rect &area);
+
+        QC::u32 *m_pixels;
+        QG::PainterSurface m_surface;
+        Rect m_rect;
+        bool m_visible;
+
+        // FPS from the compositor frame counter over roughly one second
+        QC::u64 m_fpsWindowStart;
+        QC::u32 m_fpsWindowFrames;
+        QC::u32 m_fps;
+    };
+
+} // namespace QW
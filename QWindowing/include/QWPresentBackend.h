@@ -22,6 +22,12 @@ namespace QW
         // If dirtyCount == 0, callers should interpret that as "unknown" and present the full frame.
         virtual void present(const QC::Rect * /*dirtyRects*/, QC::usize /*dirtyCount*/) { present(); }
 
+        // Optional render-target hooks (flip chains). A backend that returns a target
+        // has the compositor draw straight into it instead of the framebuffer back buffer;
+        // staleRects() then reports what that target missed since it was last presented.
+        virtual QC::u32 *acquireRenderTarget(QC::u32 & /*pitchBytes*/) { return nullptr; }
+        virtual QC::usize staleRects(QC::Rect * /*out*/, QC::usize /*maxRects*/) const { return 0; }
+
         // Optional acceleration hooks (future use)
         virtual bool supportsRectCopy() const { return false; }
         virtual void rectCopy(const QC::Rect & /*src*/, const QC::Rect & /*dst*/) {}
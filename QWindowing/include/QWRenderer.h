@@ -5,6 +5,7 @@
 
 #include "QCTypes.h"
 #include "QWWindowManager.h"
+#include "QGPixelKernels.h"
 
 namespace QW
 {
@@ -26,6 +27,9 @@ namespace QW
         void clear(Color color);
         void setPixel(QC::i32 x, QC::i32 y, Color color);
         Color getPixel(QC::i32 x, QC::i32 y) const;
+        /// Copy the target pixels under rect (clipped to the target) into dst,
+        /// where dst addresses rect.x/rect.y
+        void readPixels(const Rect &rect, QC::u32 *dst, QC::u32 dstPitch) const;
 
         void drawLine(QC::i32 x1, QC::i32 y1, QC::i32 x2, QC::i32 y2, Color color);
         void drawHLine(QC::i32 x, QC::i32 y, QC::u32 length, Color color);
@@ -52,10 +56,15 @@ namespace QW
                         QC::u32 srcWidth, QC::u32 srcHeight, QC::u32 srcPitch);
         void blitAlpha(QC::i32 x, QC::i32 y, const QC::u32 *src,
                        QC::u32 srcWidth, QC::u32 srcHeight, QC::u32 srcPitch);
+        void blitPremultiplied(QC::i32 x, QC::i32 y, const QC::u32 *src,
+                               QC::u32 srcWidth, QC::u32 srcHeight, QC::u32 srcPitch);
 
     private:
         bool clipPoint(QC::i32 &x, QC::i32 &y) const;
         bool clipRect(Rect &rect) const;
+        void blitRows(QC::i32 x, QC::i32 y, const QC::u32 *src,
+                      QC::u32 srcWidth, QC::u32 srcHeight, QC::u32 srcPitch,
+                      QG::SurfaceFormat format);
 
         QC::u32 *m_buffer;
         QC::u32 m_width;
@@ -4,6 +4,7 @@
 // Namespace: QW
 
 #include "QGGraphicsBackend.h"
+#include "QG/NinePatch.h"
 #include "QG/PainterSurface.h"
 #include "QGBrush.h"
 #include "QGPen.h"
@@ -51,11 +52,13 @@ namespace QW
                   const QC::u32 *pixels,
                   QC::u32 stride,
                   bool useAlpha) override;
+        bool scrollRect(const QC::Rect &rect, QC::i32 dx, QC::i32 dy) override;
 
     private:
         bool ensureSurface() const { return m_surface != nullptr && m_target.pixels != nullptr; }
         bool clipRect(const QC::Rect &rect, QC::Rect &clipped) const;
         void fillRectAlpha(const QC::Rect &rect, QC::Color color);
+        void drawNinePatch(const QG::NinePatch &patch, const QC::Rect &rect);
 
         QG::PainterSurface *m_surface;
         TargetDesc m_target;
@@ -0,0 +1,86 @@
+#pragma once
+
+// QWindowing SurfacePool - reusable window pixel buffers
+// Namespace: QW
+
+#include "QCTypes.h"
+
+namespace QW
+{
+
+    /// A pixel buffer on loan from SurfacePool
+    struct PooledSurface
+    {
+        QC::u32 *pixels = nullptr; // Page aligned
+        QC::u32 width = 0;
+        QC::u32 height = 0;
+        QC::u32 pitchBytes = 0;      // Row stride, padded to a cache line
+        QC::usize capacityBytes = 0; // Bucket size; any layout up to this fits
+        void *block = nullptr;       // Heap block backing `pixels`
+
+        bool isValid() const { return pixels != nullptr; }
+
+        /// Re-lay the buffer out for a new size without reallocating
+        /// @return false if the new layout does not fit, or would leave most of the buffer unused
+        bool relayout(QC::u32 newWidth, QC::u32 newHeight);
+    };
+
+    /// SurfacePool - window surfaces recycled by size bucket.
+    /// Opening a dialog, toggling the terminal or dragging a resize border
+    /// would otherwise free and allocate multi-megabyte buffers every time.
+    /// Buckets round sizes up (powers of two while small, eighths of a power
+    /// of two beyond that) so nearby sizes share buffers; released buffers
+    /// are cached up to a byte budget and trimmed when physical memory runs low.
+    class SurfacePool
+    {
+    public:
+        static constexpr QC::u32 RowAlignBytes = 64;
+        static constexpr QC::usize BufferAlignBytes = 4096;
+        static constexpr QC::usize MaxCached = 8;
+        static constexpr QC::usize DefaultBudgetBytes = 32 * 1024 * 1024;
+        /// Below this many free physical pages the cache is given back
+        static constexpr QC::usize LowMemoryPages = 4096;
+
+        static SurfacePool &instance();
+
+        /// Buffer for width x height pixels, from the cache when a bucket fits
+        PooledSurface acquire(QC::u32 width, QC::u32 height);
+
+        /// Hand a buffer back; it is cached for reuse or freed. Resets `surface`.
+        void release(PooledSurface &surface);
+
+        /// Free cached buffers until at most `keepBytes` remain cached
+        /// @return bytes returned to the heap
+        QC::usize trim(QC::usize keepBytes = 0);
+
+        void setBudget(QC::usize bytes);
+        QC::usize budget() const { return m_budgetBytes; }
+        QC::usize cachedBytes() const { return m_cachedBytes; }
+        QC::usize cachedCount() const { return m_cachedCount; }
+        QC::u64 hits() const { return m_hits; }
+        QC::u64 misses() const { return m_misses; }
+
+        /// Padded row stride for a width
+        static QC::u32 pitchFor(QC::u32 width);
+        /// Bucket a byte size rounds up to
+        static QC::usize bucketSize(QC::usize bytes);
+
+    private:
+        SurfacePool() = default;
+        SurfacePool(const SurfacePool &) = delete;
+        SurfacePool &operator=(const SurfacePool &) = delete;
+
+        /// True when the physical allocator is short of pages
+        static bool underPressure();
+        PooledSurface allocate(QC::usize capacity);
+        static void freeSurface(PooledSurface &surface);
+
+        PooledSurface m_cached[MaxCached];
+        QC::usize m_cachedCount = 0;
+        QC::usize m_cachedBytes = 0;
+        QC::usize m_budgetBytes = DefaultBudgetBytes;
+        QC::u64 m_hits = 0;
+        QC::u64 m_misses = 0;
+    };
+
+} // namespace QW
@@ -0,0 +1,80 @@
+#pragma once
+
+// QWindowing TileGrid - Screen tiles with a damage bitmap
+// Namespace: QW
+
+#include "QCTypes.h"
+#include "QCGeometry.h"
+#include "QCVector.h"
+
+namespace QW
+{
+
+    /// The screen cut into fixed TileSize x TileSize tiles with one damage bit
+    /// per tile. Marking damage costs a few bit sets however many rects arrive,
+    /// and a tile's pixels (16 KB) stay in cache while it is composed.
+    /// Tiles are numbered row-major; edge tiles are clipped to the screen.
+    class TileGrid
+    {
+    public:
+        static constexpr QC::u32 TileShift = 6;
+        static constexpr QC::u32 TileSize = 1u << TileShift;
+
+        /// Re-cut for a new screen size; every tile starts clean
+        void resize(QC::u32 width, QC::u32 height);
+
+        QC::u32 width() const { return m_width; }
+        QC::u32 height() const { return m_height; }
+        QC::u32 columns() const { return m_columns; }
+        QC::u32 rows() const { return m_rows; }
+        QC::u32 tileCount() const { return m_columns * m_rows; }
+
+        /// Mark every tile the rect touches (clipped to the screen)
+        void mark(const QC::Rect &rect);
+        void markAll();
+        void clear();
+
+        bool isEmpty() const { return m_dirtyCount == 0; }
+        bool isFull() const { return m_dirtyCount != 0 && m_dirtyCount == tileCount(); }
+        QC::u32 dirtyCount() const { return m_dirtyCount; }
+
+        bool isDirty(QC::u32 tile) const { return (m_bits[tile >> 6] >> (tile & 63)) & 1; }
+        /// True if any tile the rect touches is dirty
+        bool isDirty(const QC::Rect &rect) const;
+
+        /// First dirty tile at or after `tile`; tileCount() if there is none
+        QC::u32 nextDirty(QC::u32 tile) const;
+
+        /// Screen pixels of a tile
+        QC::Rect tileRect(QC::u32 tile) const;
+
+        /// The dirty tiles as at most `maxRects` rects (maxRects > 0): runs of
+        /// tiles along each row, stacked with the row above when they span the
+        /// same columns. Damage too scattered for that is banded into groups of
+        /// rows, so the result may then cover clean tiles too.
+        void collectRects(QC::Vector<QC::Rect> &out, QC::usize maxRects);
+
+    private:
+        /// A horizontal run of dirty tiles and the output rect it extends
+        struct TileRun
+        {
+            QC::u32 col0;
+            QC::u32 col1;
+            QC::usize rect;
+        };
+
+        /// Tile columns/rows the rect touches, as [first, last); false if off screen
+        bool tileSpan(const QC::Rect &rect, QC::u32 &col0, QC::u32 &col1, QC::u32 &row0, QC::u32 &row1) const;
+        QC::Rect spanRect(QC::u32 col0, QC::u32 col1, QC::u32 row0, QC::u32 row1) const;
+        void collectBands(QC::Vector<QC::Rect> &out, QC::usize maxRects) const;
+
+        QC::Vector<QC::u64> m_bits;
+        QC::u32 m_width = 0;
+        QC::u32 m_height = 0;
+        QC::u32 m_columns = 0;
+        QC::u32 m_rows = 0;
+        QC::u32 m_dirtyCount = 0;
+        QC::Vector<TileRun> m_runs[2]; // collectRects scratch: previous row, this row
+    };
+
+} // namespace QW
@@ -1,6 +1,6 @@
 #pragma once
 
-// QWindowing VMware SVGA Present Backend - hooks for SVGA2D present/blit (cursor-only for now)
+// QWindowing VMware SVGA Present Backend - fenced SVGA2D updates plus hardware cursor
 // Namespace: QW
 
 #include "QWPresentBackend.h"
@@ -22,7 +22,27 @@ namespace QW
         void setCursorVisible(bool visible) override;
         void setCursorPosition(QC::u16 x, QC::u16 y) override;
 
+        /// Presents the host may still be reading from VRAM
+        static constexpr QC::usize MaxInFlight = 3;
+        /// Coalesced update rects per present before falling back to full screen
+        static constexpr QC::usize MaxUpdateRects = 32;
+
     private:
+        struct InFlight
+        {
+            QC::u32 fence;
+            QC::Rect bounds;
+        };
+
+        /// Drop in-flight presents whose fence has passed
+        void retireCompleted();
+        /// Wait for every in-flight present whose area overlaps one of the rects
+        void waitForOverlap(const QC::Rect *rects, QC::usize count);
+
         Framebuffer *m_framebuffer = nullptr;
+
+        InFlight m_inFlight[MaxInFlight] = {};
+        QC::usize m_inFlightHead = 0;
+        QC::usize m_inFlightCount = 0;
     };
 }
@@ -12,6 +12,7 @@
 #include "QWStyleRenderer.h"
 #include "QWStyleTypes.h"
 #include "QWSurfaceBackend.h"
+#include "QWSurfacePool.h"
 #include "QCVector.h"
 
 namespace QG
@@ -53,6 +54,10 @@ namespace QW
         Window(const char *title, Rect bounds);
         ~Window();
 
+        // Non-copyable: the surface is on loan from the pool
+        Window(const Window &) = delete;
+        Window &operator=(const Window &) = delete;
+
         // identity
         uint32_t windowId() const;
         void setWindowId(uint32_t id);
@@ -81,10 +86,24 @@ namespace QW
         QC::u32 bufferWidth() const;
         QC::u32 bufferHeight() const;
         QC::u32 bufferPitchBytes() const;
+        /// True when the surface is opaque and covers the whole window, hiding anything below
+        bool isOpaque() const;
+        /// Alpha format of the surface; anything but Opaque is blended by the compositor
+        QG::SurfaceFormat bufferFormat() const { return m_bufferFormat; }
+        void setBufferFormat(QG::SurfaceFormat format);
 
         // invalidation
         void invalidate();
         void invalidateRect(const Rect &rect);
+        /// Move already painted content inside `rect` (window-local) by (dx, dy)
+        /// and invalidate only the strip it uncovers. Falls back to invalidating
+        /// all of `rect` when the surface has nothing to move yet.
+        void scrollRect(const Rect &rect, QC::i32 dx, QC::i32 dy);
+
+        // deferred painting: invalidation only records damage; the window
+        // manager paints each dirty window once per frame before composing
+        bool needsPaint() const { return m_paintPending; }
+        void paintPending();
 
         // event handling
         bool onEvent(const QK::Event::Event &e) override;
@@ -98,7 +117,7 @@ namespace QW
         void onResize(uint32_t w, uint32_t h);
 
     private:
-        void paint();
+        void paint(const Rect &clip);
         bool ensureSurface(QC::u32 width, QC::u32 height);
 
         uint32_t m_windowId;
@@ -111,10 +130,14 @@ namespace QW
         SurfaceBackend m_surfaceBackend;
         StyleRenderer m_styleRenderer;
         QG::PainterSurface m_painter;
-        QC::Vector<QC::u32> m_surfacePixels;
+        PooledSurface m_surface; // Pixels on loan from SurfacePool
         QC::u32 m_bufferWidth;
         QC::u32 m_bufferHeight;
         QC::u32 m_bufferPitchBytes;
+        QG::SurfaceFormat m_bufferFormat;
+
+        Rect m_dirtyRect; // Window-local bounding box of pending invalidations
+        bool m_paintPending;
 
         MessageHandler m_msgHandler = nullptr;
         void *m_msgUserData = nullptr;
@@ -0,0 +1,136 @@
+// QWindowing BGA Flip Present Backend
+// Namespace: QW
+
+#include "QWBGAFlipPresentBackend.h"
+
+#include "QWFramebuffer.h"
+#include "QDrvBGA.h"
+#include "QKMemTranslator.h"
+#include "QCLogger.h"
+#include "QCBuiltins.h"
+
+namespace QW
+{
+    void BGAFlipPresentBackend::initialize(Framebuffer *fb)
+    {
+        if (m_active)
+            return;
+
+        m_framebuffer = fb;
+        if (!fb || fb->bpp() != 32 || fb->physicalAddress() == 0)
+            return;
+
+        auto &bga = QDrv::BGA::instance();
+        if (!bga.isAvailable() && !bga.initialize())
+            return;
+
+        // Only flip when the firmware framebuffer is the BGA's current mode;
+        // otherwise the offset registers would pan someone else's surface.
+        const QC::u32 width = fb->width();
+        const QC::u32 height = fb->height();
+        if (bga.width() != width || bga.height() != height || bga.bpp() != 32 ||
+            fb->pitch() != width * sizeof(QC::u32))
+        {
+            QC_LOG_INFO("QWPresent", "BGA flip disabled: mode %ux%u@%u does not match framebuffer %ux%u",
+                        bga.width(), bga.height(), bga.bpp(), width, height);
+            return;
+        }
+
+        bga.setVirtualWidth(static_cast<QC::u16>(width));
+        if (bga.virtualHeight() < height * 2)
+        {
+            QC_LOG_INFO("QWPresent", "BGA flip disabled: virtual height %u < %u",
+                        bga.virtualHeight(), height * 2);
+            bga.setDisplayOffset(0, 0);
+            return;
+        }
+
+        const QC::usize pageSize = static_cast<QC::usize>(fb->pitch()) * height;
+        const QC::VirtAddr virt = QK::Memory::Translator::instance().mapMMIO(
+            static_cast<QC::PhysAddr>(fb->physicalAddress()),
+            pageSize * 2);
+        if (!virt)
+        {
+            QC_LOG_WARN("QWPresent", "BGA flip disabled: failed to map the second page");
+            return;
+        }
+
+        m_pages[0] = reinterpret_cast<QC::u32 *>(virt);
+        m_pages[1] = reinterpret_cast<QC::u32 *>(virt + pageSize);
+        m_pitch = fb->pitch();
+        m_back = 1;
+        m_staleCount = 0;
+        m_fullFramesPending = 2;
+
+        bga.setDisplayOffset(0, 0);
+        m_active = true;
+
+        QC_LOG_INFO("QWPresent", "BGA page flipping enabled (%ux%u, 2 pages)", width, height);
+    }
+
+    QC::u32 *BGAFlipPresentBackend::acquireRenderTarget(QC::u32 &pitchBytes)
+    {
+        if (!m_active)
+            return nullptr;
+
+        pitchBytes = m_pitch;
+        return m_pages[m_back];
+    }
+
+    QC::usize BGAFlipPresentBackend::staleRects(QC::Rect *out, QC::usize maxRects) const
+    {
+        if (!m_active || !out || maxRects == 0)
+            return 0;
+
+        if (m_fullFramesPending > 0 || m_staleCount > maxRects)
+        {
+            out[0] = QC::Rect{0, 0, m_framebuffer->width(), m_framebuffer->height()};
+            return 1;
+        }
+
+        for (QC::usize i = 0; i < m_staleCount; ++i)
+        {
+            out[i] = m_stale[i];
+        }
+        return m_staleCount;
+    }
+
+    void BGAFlipPresentBackend::present()
+    {
+        present(nullptr, 0);
+    }
+
+    void BGAFlipPresentBackend::present(const QC::Rect *dirtyRects, QC::usize dirtyCount)
+    {
+        if (!m_active)
+            return;
+
+        // Every store to the back page must be visible before scanout moves to it.
+        QC::write_barrier();
+        QDrv::BGA::instance().setDisplayOffset(
+            0, static_cast<QC::u16>(m_back * m_framebuffer->height()));
+        m_back ^= 1u;
+
+        if (m_fullFramesPending > 0)
+        {
+            --m_fullFramesPending;
+        }
+
+        // The page now behind lacks exactly this frame's damage.
+        if (!dirtyRects || dirtyCount == 0 || dirtyCount > MaxStaleRects)
+        {
+            m_staleCount = 0;
+            if (m_fullFramesPending == 0)
+            {
+                m_fullFramesPending = 1;
+            }
+            return;
+        }
+
+        for (QC::usize i = 0; i < dirtyCount; ++i)
+        {
+            m_stale[i] = dirtyRects[i];
+        }
+        m_staleCount = dirtyCount;
+    }
+}
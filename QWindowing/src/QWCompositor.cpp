@@ -5,13 +5,17 @@
 #include "QWWindow.h"
 #include "QWFramebuffer.h"
 #include "QWRenderer.h"
+#include "QWFrameScheduler.h"
+#include "QWPerfHud.h"
 #include "QKMemHeap.h"
 #include "QCMemUtil.h"
 #include "QCLogger.h"
+#include "QCBuiltins.h"
 
 #include "QWPresentBackend.h"
 #include "QWFramebufferPresentBackend.h"
 #include "QWVmwareSVGAPresentBackend.h"
+#include "QWBGAFlipPresentBackend.h"
 
 #include "QDrvVmwareSVGA.h"
 
@@ -24,12 +28,18 @@ namespace QW
     {
         // Off by default: set to 1 when you want to visually validate camera/projection math.
         static constexpr bool QAIOS_DEBUG_CAMERA_OVERLAY = false;
+
+        QC::u64 rectArea(const Rect &rect)
+        {
+            return static_cast<QC::u64>(rect.width) * rect.height;
+        }
     }
 
     Compositor::Compositor(Framebuffer *fb)
         : m_framebuffer(fb),
           m_renderer(nullptr),
           m_presentBackend(nullptr),
+          m_hud(nullptr),
           m_effects(0),
           m_wallpaper(nullptr),
           m_wallpaperWidth(0),
@@ -42,9 +52,13 @@ namespace QW
           m_cursorBackground(nullptr),
           m_cursorBackX(0),
           m_cursorBackY(0),
+          m_cursorRect(),
+          m_cursorDrawn(false),
+          m_cursorBackValid(false),
           m_lastComposeTime(0),
           m_frameCount(0)
     {
+        syncTileGrid();
     }
 
     Compositor::~Compositor()
@@ -59,6 +73,11 @@ namespace QW
             delete m_renderer;
             m_renderer = nullptr;
         }
+        if (m_hud)
+        {
+            delete m_hud;
+            m_hud = nullptr;
+        }
         if (m_wallpaper)
         {
             QK::Memory::Heap::instance().free(m_wallpaper);
@@ -79,18 +98,27 @@ namespace QW
     void Compositor::initialize()
     {
         // Select presentation backend.
-        // Default is software framebuffer swap; VMware SVGA backend is used when available.
+        // VMware SVGA backend is used when available, then BGA page flipping;
+        // the software framebuffer swap is the fallback.
         if (QDrv::VmwareSVGA::instance().initialize() && QDrv::VmwareSVGA::instance().isAvailable())
         {
             m_presentBackend = new VmwareSVGAPresentBackend();
+            m_presentBackend->initialize(m_framebuffer);
         }
         else
         {
-            m_presentBackend = new FramebufferPresentBackend();
-        }
-        if (m_presentBackend)
-        {
-            m_presentBackend->initialize(m_framebuffer);
+            auto *flip = new BGAFlipPresentBackend();
+            flip->initialize(m_framebuffer);
+            if (flip->isActive())
+            {
+                m_presentBackend = flip;
+            }
+            else
+            {
+                delete flip;
+                m_presentBackend = new FramebufferPresentBackend();
+                m_presentBackend->initialize(m_framebuffer);
+            }
         }
 
         m_renderer = new Renderer();
@@ -103,6 +131,12 @@ namespace QW
                 m_framebuffer->pitch());
         }
 
+        m_hud = new PerfHud();
+        if (m_framebuffer)
+        {
+            m_hud->setScreenSize(m_framebuffer->width(), m_framebuffer->height());
+        }
+
         // Create a simple default arrow cursor (12x16)
         static constexpr QC::u32 cursorWidth = 12;
         static constexpr QC::u32 cursorHeight = 16;
@@ -316,105 +350,338 @@ namespace QW
         if (!m_framebuffer || !m_renderer)
             return;
 
+        syncTileGrid();
+
         const bool hasHwCursor = (m_presentBackend && m_presentBackend->hasHardwareCursor());
 
         // If nothing is dirty and we have a hardware cursor, skip recompositing/presenting.
         // Cursor movement is handled via cursor registers, so we don't need framebuffer updates.
-        if (hasHwCursor && m_dirtyRegions.empty())
+        if (hasHwCursor && m_tiles.isEmpty())
         {
             syncHardwareCursorPosition();
             return;
         }
 
-        // TODO: Get timestamp for performance tracking
-        // m_lastComposeTime = ...
+        const QC::u64 composeStart = QC::rdtsc();
 
-        // Draw desktop background
-        drawDesktop();
+        // The software cursor damages both where it was and where it is now,
+        // unless pointer motion is all that changed.
+        if (!hasHwCursor)
+        {
+            if (moveSoftwareCursor())
+                return;
 
-        if (QAIOS_DEBUG_CAMERA_OVERLAY)
+            trackSoftwareCursor();
+        }
+
+        if (hasHwCursor)
         {
-            // Minimal integration demo: use the UI ortho camera to transform a simple box.
-            // This is intentionally simple and self-contained.
-            QG::UICameraOrthoRH cam;
-            cam.width = m_framebuffer->width();
-            cam.height = m_framebuffer->height();
+            syncHardwareCursorPosition();
+        }
+
+        if (m_tiles.isEmpty())
+            return;
 
-            // A 64x64 box in pixel space.
-            const QC::Vec3f p0{24.0f, 24.0f, 0.0f};
-            const QC::Vec3f p1{24.0f + 64.0f, 24.0f, 0.0f};
-            const QC::Vec3f p2{24.0f + 64.0f, 24.0f + 64.0f, 0.0f};
-            const QC::Vec3f p3{24.0f, 24.0f + 64.0f, 0.0f};
+        // Present this frame's damaged tiles (plus the HUD's own rect, kept
+        // out of its figures).
+        const bool hud = isHudVisible();
+        const bool fullPresent = m_tiles.isFull();
+        m_tiles.collectRects(m_presentRects, hud ? MaxPresentRects - 1 : MaxPresentRects);
 
-            // Transform through view-proj and back to pixel space (since our renderer is pixel-based).
-            // For now, this just exercises the math path; the visual is a simple box.
-            (void)QC::transformPoint(cam.viewProj(), p0);
-            (void)QC::transformPoint(cam.viewProj(), p1);
-            (void)QC::transformPoint(cam.viewProj(), p2);
-            (void)QC::transformPoint(cam.viewProj(), p3);
+        // A flip chain hands out the page to draw into; that page holds the
+        // frame before last, so it also needs the damage it missed since.
+        // That is recomposed but not presented again.
+        if (m_presentBackend)
+        {
+            QC::u32 targetPitch = 0;
+            if (QC::u32 *target = m_presentBackend->acquireRenderTarget(targetPitch))
+            {
+                m_renderer->setTarget(target, m_framebuffer->width(), m_framebuffer->height(), targetPitch);
 
-            // Draw directly in pixel space.
-            m_renderer->drawRect(Rect{24, 24, 64, 64}, Color(255, 0, 255, 255));
+                QC::Rect staleRects[MaxStaleRects];
+                const QC::usize staleCount = m_presentBackend->staleRects(staleRects, MaxStaleRects);
+                for (QC::usize i = 0; i < staleCount; ++i)
+                {
+                    m_tiles.mark(staleRects[i]);
+                }
+            }
         }
 
-        // Compose all windows from bottom to top
-        auto &wm = WindowManager::instance();
-        for (QC::usize i = 0; i < wm.windowCount(); ++i)
+        if (hud)
         {
-            Window *window = wm.windowAtIndex(i);
-            if (window && window->isVisible())
+            QC::u64 damagedPixels = 0;
+            for (QC::u32 tile = m_tiles.nextDirty(0); tile < m_tiles.tileCount(); tile = m_tiles.nextDirty(tile + 1))
             {
-                composeWindow(window);
+                damagedPixels += rectArea(m_tiles.tileRect(tile));
             }
+            m_hud->update(damagedPixels, fullPresent, m_frameCount);
+
+            m_tiles.mark(m_hud->rect());
+            m_presentRects.push_back(m_hud->rect());
         }
 
-        // Draw cursor
-        Point mousePos = wm.mousePosition();
-        if (hasHwCursor)
+        // Recompose only the damaged tiles; the target keeps the rest
+        // of the frame it last showed.
+        buildTileJobs();
+        composeTiles(*m_renderer, 0, m_tileJobs.size());
+        m_renderer->clearClipRect();
+
+        // A moved cursor damages its whole rect, so the tiles composed above
+        // refreshed all of the overlay's saved background.
+        if (m_cursorDrawn && m_tiles.isDirty(m_cursorRect))
         {
-            syncHardwareCursorPosition();
+            m_cursorBackX = m_cursorRect.x;
+            m_cursorBackY = m_cursorRect.y;
+        }
+        m_cursorBackValid = m_cursorDrawn && m_cursorBackground &&
+                            m_cursorBackX == m_cursorRect.x && m_cursorBackY == m_cursorRect.y;
+
+        FrameScheduler::instance().addTime(FrameMetric::Compose, QC::rdtsc() - composeStart);
+
+        presentRects(m_presentRects.data(), m_presentRects.size());
+
+        m_lastComposeTime = QC::rdtsc() - composeStart;
+        m_frameCount++;
+        clearDirtyRegions();
+    }
+
+    void Compositor::setHudVisible(bool visible)
+    {
+        if (!m_hud || m_hud->isVisible() == visible)
+            return;
+
+        m_hud->setVisible(visible);
+
+        // Showing needs a frame to draw it; hiding needs the scene back.
+        WindowManager::instance().invalidate(m_hud->rect());
+    }
+
+    bool Compositor::isHudVisible() const
+    {
+        return m_hud && m_hud->isVisible();
+    }
+
+    void Compositor::presentRects(const QC::Rect *rects, QC::usize count)
+    {
+        const QC::u64 presentStart = QC::rdtsc();
+        if (m_presentBackend)
+        {
+            m_presentBackend->present(rects, count);
         }
         else
         {
-            drawCursor(mousePos.x, mousePos.y);
+            m_framebuffer->swap(rects, count);
         }
+        FrameScheduler::instance().addTime(FrameMetric::Present, QC::rdtsc() - presentStart);
+    }
 
-        // Present frame
-        if (m_presentBackend)
+    void Compositor::buildTileJobs()
+    {
+        auto &wm = WindowManager::instance();
+
+        m_stack.clear();
+        for (QC::usize n = wm.windowCount(); n > 0; --n)
         {
-            // Present only dirty rectangles when supported.
-            static constexpr QC::usize kMaxDirtyRects = 64;
-            QC::Rect dirtyRects[kMaxDirtyRects];
-            QC::usize dirtyCount = m_dirtyRegions.size();
+            Window *window = wm.windowAtIndex(n - 1);
+            if (!window || !window->isVisible())
+                continue;
+            m_stack.push_back(StackEntry{window, window->bounds(), window->isOpaque()});
+        }
+
+        const bool hud = isHudVisible();
+        const Rect hudRect = hud ? m_hud->rect() : Rect{};
 
-            if (dirtyCount == 0)
+        // Each tile lists the windows over it down to the first opaque one
+        // that covers it completely; below that nothing shows through.
+        m_tileJobs.clear();
+        m_tileWindows.clear();
+        for (QC::u32 tile = m_tiles.nextDirty(0); tile < m_tiles.tileCount(); tile = m_tiles.nextDirty(tile + 1))
+        {
+            const Rect tileRect = m_tiles.tileRect(tile);
+            TileJob job{tile, static_cast<QC::u32>(m_tileWindows.size()), 0, true};
+
+            // The HUD is opaque and above every window.
+            if (hud && hudRect.contains(tileRect))
             {
-                // No changes recorded; keep legacy behavior for the software cursor path.
-                // (With hardware cursor, we'd have returned above.)
-                m_presentBackend->present();
+                job.background = false;
             }
-            else if (dirtyCount > kMaxDirtyRects)
+            else
             {
-                // Too many rects; cheaper to do a full present.
-                m_presentBackend->present();
+                for (QC::usize i = 0; i < m_stack.size(); ++i)
+                {
+                    const StackEntry &entry = m_stack[i];
+                    if (!entry.bounds.intersects(tileRect))
+                        continue;
+
+                    m_tileWindows.push_back(entry.window);
+                    ++job.count;
+                    if (entry.opaque && entry.bounds.contains(tileRect))
+                    {
+                        job.background = false;
+                        break;
+                    }
+                }
             }
-            else
+
+            m_tileJobs.push_back(job);
+        }
+    }
+
+    void Compositor::composeTiles(Renderer &renderer, QC::usize begin, QC::usize end)
+    {
+        for (QC::usize i = begin; i < end; ++i)
+        {
+            composeTile(renderer, m_tileJobs[i]);
+        }
+    }
+
+    void Compositor::composeTile(Renderer &renderer, const TileJob &job)
+    {
+        const Rect tileRect = m_tiles.tileRect(job.tile);
+        renderer.setClipRect(tileRect);
+
+        // Desktop background only where no opaque window covers the tile
+        if (job.background)
+        {
+            drawDesktop(renderer);
+
+            if (QAIOS_DEBUG_CAMERA_OVERLAY)
             {
-                for (QC::usize i = 0; i < dirtyCount; ++i)
+                // Minimal integration demo: use the UI ortho camera to transform a simple box.
+                // This is intentionally simple and self-contained.
+                QG::UICameraOrthoRH cam;
+                cam.width = m_framebuffer->width();
+                cam.height = m_framebuffer->height();
+
+                // A 64x64 box in pixel space.
+                const QC::Vec3f p0{24.0f, 24.0f, 0.0f};
+                const QC::Vec3f p1{24.0f + 64.0f, 24.0f, 0.0f};
+                const QC::Vec3f p2{24.0f + 64.0f, 24.0f + 64.0f, 0.0f};
+                const QC::Vec3f p3{24.0f, 24.0f + 64.0f, 0.0f};
+
+                // Transform through view-proj and back to pixel space (since our renderer is pixel-based).
+                // For now, this just exercises the math path; the visual is a simple box.
+                (void)QC::transformPoint(cam.viewProj(), p0);
+                (void)QC::transformPoint(cam.viewProj(), p1);
+                (void)QC::transformPoint(cam.viewProj(), p2);
+                (void)QC::transformPoint(cam.viewProj(), p3);
+
+                // Draw directly in pixel space.
+                renderer.drawRect(Rect{24, 24, 64, 64}, Color(255, 0, 255, 255));
+            }
+        }
+
+        // Windows from the bottom of the tile's list to the top
+        for (QC::u32 i = job.count; i > 0; --i)
+        {
+            composeWindow(renderer, m_tileWindows[job.first + i - 1]);
+        }
+
+        if (isHudVisible())
+        {
+            const Rect hudRect = m_hud->rect();
+            const Rect part = tileRect.intersection(hudRect);
+            if (!part.isEmpty())
+            {
+                renderer.setClipRect(part);
+                renderer.blit(hudRect.x, hudRect.y, m_hud->pixels(), PerfHud::Width, PerfHud::Height, m_hud->pitch());
+            }
+        }
+
+        // Cursor (tiles are disjoint, so it is blended once)
+        if (m_cursorDrawn)
+        {
+            const Rect part = tileRect.intersection(m_cursorRect);
+            if (!part.isEmpty())
+            {
+                // Keep the overlay's saved background in step with the scene
+                // composed underneath before the cursor is blended over it.
+                if (m_cursorBackground)
                 {
-                    dirtyRects[i] = m_dirtyRegions[i].rect;
+                    renderer.readPixels(
+                        part,
+                        m_cursorBackground + (part.y - m_cursorRect.y) * static_cast<QC::i32>(m_cursorWidth) +
+                            (part.x - m_cursorRect.x),
+                        m_cursorWidth * sizeof(QC::u32));
                 }
 
-                m_presentBackend->present(dirtyRects, dirtyCount);
+                renderer.setClipRect(part);
+                drawCursor(renderer, m_cursorRect.x + m_cursorHotspotX, m_cursorRect.y + m_cursorHotspotY);
             }
         }
-        else
+    }
+
+    bool Compositor::moveSoftwareCursor()
+    {
+        if (!m_tiles.isEmpty())
+            return false;
+        if (!m_cursorPixels || !m_cursorDrawn || !m_cursorBackValid)
+            return false;
+
+        // A flip chain renders into a different page every frame, which the
+        // saved background does not describe.
+        QC::u32 targetPitch = 0;
+        if (m_presentBackend && m_presentBackend->acquireRenderTarget(targetPitch))
+            return false;
+
+        const Point mousePos = WindowManager::instance().mousePosition();
+        const Rect cursorRect{mousePos.x - m_cursorHotspotX, mousePos.y - m_cursorHotspotY,
+                              m_cursorWidth, m_cursorHeight};
+        if (cursorRect == m_cursorRect)
+            return true;
+
+        const QC::u64 composeStart = QC::rdtsc();
+        const Rect oldRect = m_cursorRect;
+        restoreCursorBackground();
+        saveCursorBackground(cursorRect.x, cursorRect.y);
+        m_cursorRect = cursorRect;
+
+        m_renderer->setClipRect(cursorRect);
+        drawCursor(*m_renderer, mousePos.x, mousePos.y);
+        m_renderer->clearClipRect();
+
+        QC::Rect dirtyRects[2] = {oldRect, cursorRect};
+        QC::usize dirtyCount = 2;
+        if (oldRect.intersects(cursorRect))
         {
-            m_framebuffer->swap();
+            dirtyRects[0] = oldRect.united(cursorRect);
+            dirtyCount = 1;
         }
+        FrameScheduler::instance().addTime(FrameMetric::Compose, QC::rdtsc() - composeStart);
+        presentRects(dirtyRects, dirtyCount);
 
+        m_lastComposeTime = QC::rdtsc() - composeStart;
         m_frameCount++;
-        clearDirtyRegions();
+        return true;
+    }
+
+    void Compositor::trackSoftwareCursor()
+    {
+        if (!m_cursorPixels)
+        {
+            if (m_cursorDrawn)
+            {
+                addDamage(m_cursorRect);
+                m_cursorDrawn = false;
+            }
+            return;
+        }
+
+        const Point mousePos = WindowManager::instance().mousePosition();
+        const Rect cursorRect{mousePos.x - m_cursorHotspotX, mousePos.y - m_cursorHotspotY,
+                              m_cursorWidth, m_cursorHeight};
+
+        if (!m_cursorDrawn || cursorRect != m_cursorRect)
+        {
+            if (m_cursorDrawn)
+            {
+                addDamage(m_cursorRect);
+            }
+            addDamage(cursorRect);
+        }
+
+        m_cursorRect = cursorRect;
+        m_cursorDrawn = true;
     }
 
     void Compositor::syncHardwareCursorPosition()
@@ -445,49 +712,77 @@ namespace QW
             static_cast<QC::u16>(cy));
     }
 
-    void Compositor::composeWindow(Window *window)
+    void Compositor::composeWindow(Renderer &renderer, Window *window)
     {
-        if (!window || !m_renderer)
+        if (!window)
             return;
 
         // Draw window decorations
         if (window->flags() & WindowFlags::HasBorder)
         {
-            drawWindowDecorations(window);
+            drawWindowDecorations(renderer, window);
         }
 
         // Blit window content
         Rect bounds = window->bounds();
         if (window->buffer())
         {
-            m_renderer->blit(
-                bounds.x, bounds.y,
-                window->buffer(),
-                window->bufferWidth(),
-                window->bufferHeight(),
-                window->bufferPitchBytes());
+            switch (window->bufferFormat())
+            {
+            case QG::SurfaceFormat::Opaque:
+                renderer.blit(bounds.x, bounds.y, window->buffer(),
+                              window->bufferWidth(), window->bufferHeight(),
+                              window->bufferPitchBytes());
+                break;
+            case QG::SurfaceFormat::Premultiplied:
+                renderer.blitPremultiplied(bounds.x, bounds.y, window->buffer(),
+                                           window->bufferWidth(), window->bufferHeight(),
+                                           window->bufferPitchBytes());
+                break;
+            case QG::SurfaceFormat::Straight:
+                renderer.blitAlpha(bounds.x, bounds.y, window->buffer(),
+                                   window->bufferWidth(), window->bufferHeight(),
+                                   window->bufferPitchBytes());
+                break;
+            }
         }
     }
 
     void Compositor::invalidate(const Rect &rect)
     {
-        DirtyRegion region;
-        region.rect = rect;
-        region.merged = false;
-        m_dirtyRegions.push_back(region);
+        addDamage(rect);
     }
 
     void Compositor::invalidateAll()
     {
-        if (m_framebuffer)
+        syncTileGrid();
+        m_tiles.markAll();
+    }
+
+    void Compositor::clearDirtyRegions()
+    {
+        m_tiles.clear();
+    }
+
+    void Compositor::syncTileGrid()
+    {
+        if (!m_framebuffer)
+            return;
+
+        if (m_tiles.width() != m_framebuffer->width() || m_tiles.height() != m_framebuffer->height())
         {
-            invalidate(Rect{0, 0, m_framebuffer->width(), m_framebuffer->height()});
+            m_tiles.resize(m_framebuffer->width(), m_framebuffer->height());
+            m_tiles.markAll();
         }
     }
 
-    void Compositor::clearDirtyRegions()
+    void Compositor::addDamage(const Rect &rect)
     {
-        m_dirtyRegions.clear();
+        if (!m_framebuffer)
+            return;
+
+        syncTileGrid();
+        m_tiles.mark(rect);
     }
 
     void Compositor::setEffect(CompositionEffect effect, bool enabled)
@@ -509,17 +804,15 @@ namespace QW
         return (m_effects & bit) != 0;
     }
 
-    void Compositor::drawWindowDecorations(Window *window)
+    void Compositor::drawWindowDecorations(Renderer &renderer, Window *window)
     {
-        if (!window || !m_renderer)
+        if (!window)
             return;
 
-        Rect bounds = window->bounds();
-
         // Draw border
         if (window->flags() & WindowFlags::HasBorder)
         {
-            drawBorder(window);
+            drawBorder(renderer, window);
         }
 
         // Draw title bar
@@ -541,14 +834,14 @@ namespace QW
         // TODO: Draw title bar with title text and buttons
     }
 
-    void Compositor::drawBorder(Window *window)
+    void Compositor::drawBorder(Renderer &renderer, Window *window)
     {
-        if (!window || !m_renderer)
+        if (!window)
             return;
 
         Rect bounds = window->bounds();
         Color borderColor = Color::fromRGB(100, 100, 100);
-        m_renderer->drawRect(bounds, borderColor);
+        renderer.drawRect(bounds, borderColor);
     }
 
     void Compositor::drawShadow(Window *window)
@@ -576,28 +869,35 @@ namespace QW
                 m_wallpaperHeight = height;
             }
         }
+
+        invalidateAll();
     }
 
-    void Compositor::drawDesktop()
+    void Compositor::drawDesktop(Renderer &renderer)
     {
-        if (!m_renderer)
-            return;
-
         if (m_wallpaper)
         {
-            m_renderer->blit(0, 0, m_wallpaper, m_wallpaperWidth, m_wallpaperHeight,
-                             m_wallpaperWidth * sizeof(QC::u32));
+            renderer.blit(0, 0, m_wallpaper, m_wallpaperWidth, m_wallpaperHeight,
+                          m_wallpaperWidth * sizeof(QC::u32));
         }
         else
         {
             // Default desktop background
-            m_renderer->clear(Color::fromRGB(0, 128, 128));
+            renderer.clear(Color::fromRGB(0, 128, 128));
         }
     }
 
     void Compositor::setCursor(const QC::u32 *pixels, QC::u32 width, QC::u32 height,
                                QC::i32 hotspotX, QC::i32 hotspotY)
     {
+        // The old image must be recomposed away.
+        if (m_cursorDrawn)
+        {
+            addDamage(m_cursorRect);
+            m_cursorDrawn = false;
+        }
+        m_cursorBackValid = false;
+
         if (m_cursorPixels)
         {
             QK::Memory::Heap::instance().free(m_cursorPixels);
@@ -646,34 +946,41 @@ namespace QW
         }
     }
 
-    void Compositor::drawCursor(QC::i32 x, QC::i32 y)
+    void Compositor::drawCursor(Renderer &renderer, QC::i32 x, QC::i32 y)
     {
-        if (!m_cursorPixels || !m_renderer)
+        if (!m_cursorPixels)
             return;
 
         QC::i32 drawX = x - m_cursorHotspotX;
         QC::i32 drawY = y - m_cursorHotspotY;
 
-        m_renderer->blitAlpha(drawX, drawY, m_cursorPixels,
-                              m_cursorWidth, m_cursorHeight,
-                              m_cursorWidth * sizeof(QC::u32));
+        renderer.blitAlpha(drawX, drawY, m_cursorPixels,
+                           m_cursorWidth, m_cursorHeight,
+                           m_cursorWidth * sizeof(QC::u32));
     }
 
     void Compositor::saveCursorBackground(QC::i32 x, QC::i32 y)
     {
-        (void)x;
-        (void)y;
-        // TODO: Save background under cursor for restoration
+        if (!m_cursorBackground || !m_renderer)
+            return;
+
+        m_renderer->readPixels(Rect{x, y, m_cursorWidth, m_cursorHeight},
+                               m_cursorBackground, m_cursorWidth * sizeof(QC::u32));
+        m_cursorBackX = x;
+        m_cursorBackY = y;
+        m_cursorBackValid = true;
     }
 
     void Compositor::restoreCursorBackground()
     {
-        // TODO: Restore saved background
-    }
+        if (!m_cursorBackground || !m_cursorBackValid || !m_renderer)
+            return;
 
-    void Compositor::mergeDirtyRegions()
-    {
-        // TODO: Merge overlapping dirty regions for efficiency
+        // Off-screen parts of the saved block were never read; blit() clips them away.
+        m_renderer->clearClipRect();
+        m_renderer->blit(m_cursorBackX, m_cursorBackY, m_cursorBackground,
+                         m_cursorWidth, m_cursorHeight, m_cursorWidth * sizeof(QC::u32));
+        m_cursorBackValid = false;
     }
 
 } // namespace QW
@@ -0,0 +1,170 @@
+// QWindowing Frame Scheduler - frame pacing and per-stage frame timing
+// Namespace: QW
+
+#include "QWFrameScheduler.h"
+#include "QCLogger.h"
+
+namespace QW
+{
+
+    namespace
+    {
+        // Log percentiles every this many frames (about ten seconds at 60 Hz).
+        constexpr QC::u32 kSummaryInterval = 600;
+    }
+
+    FrameScheduler &FrameScheduler::instance()
+    {
+        static FrameScheduler s_instance;
+        return s_instance;
+    }
+
+    void FrameScheduler::initialize(QC::u64 tscFrequency, QC::u32 targetHz)
+    {
+        m_tscFrequency = tscFrequency;
+        setTargetRate(targetHz);
+        m_current = FrameSample{};
+        m_oldestInput = 0;
+        m_head = 0;
+        m_count = 0;
+        m_frameCount = 0;
+        m_missedFrames = 0;
+    }
+
+    void FrameScheduler::setTargetRate(QC::u32 hz)
+    {
+        m_targetHz = hz;
+        m_interval = (m_tscFrequency != 0 && hz != 0) ? m_tscFrequency / hz : 0;
+        m_nextFrame = 0;
+    }
+
+    void FrameScheduler::beginFrame(QC::u64 now)
+    {
+        m_frameStart = now;
+    }
+
+    void FrameScheduler::addTime(FrameMetric stage, QC::u64 cycles)
+    {
+        const auto index = static_cast<QC::usize>(stage);
+        if (index < static_cast<QC::usize>(FrameMetric::Total))
+        {
+            m_current.values[index] += cycles;
+        }
+    }
+
+    void FrameScheduler::noteInput(QC::u64 timestamp)
+    {
+        if (timestamp != 0 && (m_oldestInput == 0 || timestamp < m_oldestInput))
+        {
+            m_oldestInput = timestamp;
+        }
+    }
+
+    void FrameScheduler::endFrame(QC::u64 now)
+    {
+        FrameSample &sample = m_current;
+        sample.values[static_cast<QC::usize>(FrameMetric::Total)] =
+            sample.values[static_cast<QC::usize>(FrameMetric::Events)] + (now - m_frameStart);
+        sample.values[static_cast<QC::usize>(FrameMetric::InputLatency)] =
+            (m_oldestInput != 0 && now > m_oldestInput) ? now - m_oldestInput : 0;
+
+        m_history[m_head] = sample;
+        m_head = (m_head + 1) % HistorySize;
+        if (m_count < HistorySize)
+        {
+            ++m_count;
+        }
+        ++m_frameCount;
+
+        m_current = FrameSample{};
+        m_oldestInput = 0;
+
+        // Next slot on the fixed grid; a late frame skips the slots it overran
+        // instead of bursting to catch up.
+        if (m_interval != 0)
+        {
+            // After an idle stretch the grid restarts at this frame.
+            if (m_nextFrame == 0 || m_frameStart >= m_nextFrame + m_interval)
+            {
+                m_nextFrame = m_frameStart;
+            }
+            m_nextFrame += m_interval;
+            if (m_nextFrame <= now)
+            {
+                ++m_missedFrames;
+                m_nextFrame = now + m_interval - (now - m_nextFrame) % m_interval;
+            }
+        }
+
+        if ((m_frameCount % kSummaryInterval) == 0)
+        {
+            logSummary();
+        }
+    }
+
+    QC::u64 FrameScheduler::recentValue(FrameMetric metric, QC::usize age) const
+    {
+        const auto index = static_cast<QC::usize>(metric);
+        if (age >= m_count || index >= MetricCount)
+            return 0;
+
+        return m_history[(m_head + HistorySize - 1 - age) % HistorySize].values[index];
+    }
+
+    QC::u64 FrameScheduler::percentile(FrameMetric metric, QC::u32 pct) const
+    {
+        const auto index = static_cast<QC::usize>(metric);
+        if (m_count == 0 || index >= MetricCount)
+            return 0;
+        if (pct > 100)
+            pct = 100;
+
+        // Input latency only exists for frames that carried input.
+        const bool skipZero = (metric == FrameMetric::InputLatency);
+
+        QC::u64 values[HistorySize];
+        QC::usize n = 0;
+        for (QC::usize i = 0; i < m_count; ++i)
+        {
+            const QC::u64 v = m_history[i].values[index];
+            if (skipZero && v == 0)
+                continue;
+
+            // Insertion sort: the history is small and this is off the frame path.
+            QC::usize j = n++;
+            while (j > 0 && values[j - 1] > v)
+            {
+                values[j] = values[j - 1];
+                --j;
+            }
+            values[j] = v;
+        }
+
+        if (n == 0)
+            return 0;
+
+        return values[(static_cast<QC::usize>(pct) * (n - 1) + 50) / 100];
+    }
+
+    void FrameScheduler::logSummary() const
+    {
+        // Microseconds when the TSC is calibrated, raw cycles otherwise.
+        const QC::u64 perUs = m_tscFrequency / 1'000'000u;
+        auto us = [perUs](QC::u64 cycles) -> unsigned long long
+        {
+            return static_cast<unsigned long long>(perUs ? cycles / perUs : cycles);
+        };
+
+        QC_LOG_INFO("QWFrame",
+                    "frames=%u missed=%u p50/p99 %s: total=%llu/%llu events=%llu/%llu paint=%llu/%llu "
+                    "compose=%llu/%llu present=%llu/%llu input=%llu/%llu",
+                    m_frameCount, m_missedFrames, perUs ? "us" : "cycles",
+                    us(percentile(FrameMetric::Total, 50)), us(percentile(FrameMetric::Total, 99)),
+                    us(percentile(FrameMetric::Events, 50)), us(percentile(FrameMetric::Events, 99)),
+                    us(percentile(FrameMetric::Paint, 50)), us(percentile(FrameMetric::Paint, 99)),
+                    us(percentile(FrameMetric::Compose, 50)), us(percentile(FrameMetric::Compose, 99)),
+                    us(percentile(FrameMetric::Present, 50)), us(percentile(FrameMetric::Present, 99)),
+                    us(percentile(FrameMetric::InputLatency, 50)), us(percentile(FrameMetric::InputLatency, 99)));
+    }
+
+} // namespace QW
@@ -7,6 +7,9 @@
 #include "QCMemUtil.h"
 #include "QCBuiltins.h"
 #include "QCLogger.h"
+#include "QGPixelKernels.h"
+
+#include <emmintrin.h>
 
 // Provided by the kernel boot code (QKMain.cpp)
 extern QC::u64 getHHDMOffset();
@@ -16,26 +19,48 @@ namespace QW
 
     namespace
     {
-        inline void memcpy_stream64(void *dst, const void *src, QC::usize bytes)
+        // Copy with non-temporal stores so the data bypasses the cache on its
+        // way to VRAM. The destination is 16-byte aligned with 4-byte stores
+        // first; callers issue one sfence after all spans are written.
+        inline void streamCopy(void *dst, const void *src, QC::usize bytes)
         {
             auto *d = static_cast<QC::u8 *>(dst);
             auto *s = static_cast<const QC::u8 *>(src);
 
-            QC::usize i = 0;
-            for (; i + sizeof(QC::u64) <= bytes; i += sizeof(QC::u64))
+            while (bytes >= sizeof(QC::u32) && (reinterpret_cast<QC::uptr>(d) & 15) != 0)
             {
-                const QC::u64 v = *reinterpret_cast<const QC::u64 *>(s + i);
-                asm volatile("movnti %1, %0" : "=m"(*reinterpret_cast<volatile QC::u64 *>(d + i)) : "r"(v));
+                _mm_stream_si32(reinterpret_cast<int *>(d), *reinterpret_cast<const int *>(s));
+                d += sizeof(QC::u32);
+                s += sizeof(QC::u32);
+                bytes -= sizeof(QC::u32);
             }
 
-            // Tail bytes (rare for our current 32bpp modes)
-            for (; i < bytes; ++i)
+            for (; bytes >= 64; bytes -= 64, d += 64, s += 64)
+            {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + 16));
+                const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + 32));
+                const __m128i e = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + 48));
+                _mm_stream_si128(reinterpret_cast<__m128i *>(d), a);
+                _mm_stream_si128(reinterpret_cast<__m128i *>(d + 16), b);
+                _mm_stream_si128(reinterpret_cast<__m128i *>(d + 32), c);
+                _mm_stream_si128(reinterpret_cast<__m128i *>(d + 48), e);
+            }
+            for (; bytes >= 16; bytes -= 16, d += 16, s += 16)
             {
-                d[i] = s[i];
+                _mm_stream_si128(reinterpret_cast<__m128i *>(d),
+                                 _mm_loadu_si128(reinterpret_cast<const __m128i *>(s)));
+            }
+            for (; bytes >= sizeof(QC::u32); bytes -= sizeof(QC::u32), d += sizeof(QC::u32), s += sizeof(QC::u32))
+            {
+                _mm_stream_si32(reinterpret_cast<int *>(d), *reinterpret_cast<const int *>(s));
             }
 
-            // Ensure streaming stores are globally visible.
-            QC::write_barrier();
+            // Tail bytes (only for 16/24bpp spans)
+            for (; bytes > 0; --bytes)
+            {
+                *d++ = *s++;
+            }
         }
     }
 
@@ -158,27 +183,47 @@ namespace QW
     }
 
     void Framebuffer::swap()
+    {
+        swap(nullptr, 0);
+    }
+
+    void Framebuffer::swap(const QC::Rect *rects, QC::usize count)
     {
         if (!m_doubleBuffered || !m_buffer || !m_backBuffer)
             return;
 
-        const QC::usize bytes = m_pitch * m_height;
+        auto *front = static_cast<QC::u8 *>(m_buffer);
+        const auto *back = static_cast<const QC::u8 *>(m_backBuffer);
 
-        // Copy back buffer to front buffer.
-        // If the frontbuffer is a cacheable mapping (HHDM), use non-temporal stores so VRAM
-        // sees the update without requiring an expensive full-cache flush.
-        if (m_frontbufferIsMMIO)
-            memcpy(m_buffer, m_backBuffer, bytes);
+        if (!rects || count == 0)
+        {
+            streamCopy(front, back, static_cast<QC::usize>(m_pitch) * m_height);
+        }
         else
         {
-            memcpy_stream64(m_buffer, m_backBuffer, bytes);
+            const QC::Rect screen(0, 0, m_width, m_height);
+            const QC::u32 bytesPerPixel = m_bpp / 8;
 
-            // Debug/reliability: some emulated SVGA framebuffers behave poorly when mapped as
-            // cacheable RAM via HHDM. Even with non-temporal stores + sfence, scanout can appear
-            // stale/black. A full cache writeback is expensive, but it makes the write visibility
-            // question unambiguous.
-            QC::wbinvd();
+            for (QC::usize i = 0; i < count; ++i)
+            {
+                const QC::Rect r = rects[i].intersection(screen);
+                if (r.isEmpty())
+                    continue;
+
+                const QC::usize offset = static_cast<QC::usize>(r.y) * m_pitch +
+                                         static_cast<QC::usize>(r.x) * bytesPerPixel;
+                const QC::usize rowBytes = static_cast<QC::usize>(r.width) * bytesPerPixel;
+                for (QC::u32 row = 0; row < r.height; ++row)
+                {
+                    const QC::usize rowOffset = offset + static_cast<QC::usize>(row) * m_pitch;
+                    streamCopy(front + rowOffset, back + rowOffset, rowBytes);
+                }
+            }
         }
+
+        // Non-temporal stores skip the cache, so one sfence makes the whole
+        // frame visible to scanout; no cache writeback is needed.
+        QC::write_barrier();
     }
 
     void Framebuffer::setPixel(QC::u32 x, QC::u32 y, QC::u32 color)
@@ -263,6 +308,17 @@ namespace QW
         if (!target)
             return;
 
+        if (m_format == PixelFormat::ARGB8888 || m_format == PixelFormat::ABGR8888)
+        {
+            const QG::PixelKernels &kernels = QG::PixelKernels::instance();
+            QC::u8 *row = static_cast<QC::u8 *>(target) + y * m_pitch;
+            for (QC::u32 i = 0; i < h; ++i, row += m_pitch)
+            {
+                kernels.fill(reinterpret_cast<QC::u32 *>(row) + x, color, w);
+            }
+            return;
+        }
+
         for (QC::u32 row = y; row < y + h; ++row)
         {
             for (QC::u32 col = x; col < x + w; ++col)
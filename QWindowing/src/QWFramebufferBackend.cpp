@@ -1,6 +1,8 @@
 // QWindowing FramebufferBackend implementation
 
 #include "QWFramebufferBackend.h"
+#include "QG/NinePatch.h"
+#include "QGPixelKernels.h"
 
 #include <algorithm>
 
@@ -17,7 +19,7 @@ namespace QW
     FramebufferBackend::FramebufferBackend(Framebuffer *framebuffer)
         : m_framebuffer(framebuffer)
     {
-        m_caps.supportsRoundedRect = false;
+        m_caps.supportsRoundedRect = true;
         m_caps.supportsShadows = true;
         m_caps.supportsAlpha = true;
         updateTarget();
@@ -134,8 +136,17 @@ namespace QW
                                              QC::Color stroke,
                                              QC::u32 strokeWidth)
     {
-        (void)radius; // TODO: add rounded corner rasterization
-        drawRect(rect, fill, stroke, strokeWidth);
+        if (!updateTarget() || rect.isEmpty())
+            return;
+
+        const QG::NinePatch *patch = QG::NinePatchCache::instance().roundedRectFor(rect, radius, strokeWidth, fill, stroke);
+        if (!patch)
+        {
+            drawRect(rect, fill, stroke, strokeWidth);
+            return;
+        }
+
+        drawNinePatch(*patch, rect);
     }
 
     void FramebufferBackend::drawShadow(const QC::Rect &rect,
@@ -144,17 +155,21 @@ namespace QW
                                         QC::Color color,
                                         QC::u8 opacity)
     {
-        (void)blurRadius; // Future blur support
-        if (!updateTarget())
+        if (!updateTarget() || opacity == 0 || rect.isEmpty())
             return;
 
-        if (opacity == 0)
+        const QC::Rect shadowRect = rect.offset(offset.x, offset.y);
+        const QC::Color tint = color.withAlpha(opacity);
+
+        QC::Rect patchRect;
+        const QG::NinePatch *patch = QG::NinePatchCache::instance().shadowFor(shadowRect, blurRadius, tint, patchRect);
+        if (!patch)
+        {
+            fillRectAlpha(shadowRect, tint);
             return;
+        }
 
-        QC::Rect shadow = rect;
-        shadow.x += offset.x;
-        shadow.y += offset.y;
-        fillRectAlpha(shadow, color.withAlpha(opacity));
+        drawNinePatch(*patch, patchRect);
     }
 
     void FramebufferBackend::blit(const QC::Rect &rect,
@@ -181,6 +196,21 @@ namespace QW
         }
     }
 
+    bool FramebufferBackend::scrollRect(const QC::Rect &rect, QC::i32 dx, QC::i32 dy)
+    {
+        if (!updateTarget())
+            return false;
+
+        QC::Rect clipped;
+        if (!clipRect(rect, clipped))
+            return true;
+
+        QG::PixelKernels::instance().moveRect(reinterpret_cast<QC::u32 *>(m_target.pixels),
+                                              m_target.pitch / sizeof(QC::u32),
+                                              clipped, dx, dy);
+        return true;
+    }
+
     bool FramebufferBackend::updateTarget()
     {
         if (!m_framebuffer)
@@ -238,6 +268,15 @@ namespace QW
         return true;
     }
 
+    void FramebufferBackend::drawNinePatch(const QG::NinePatch &patch, const QC::Rect &rect)
+    {
+        QC::Rect clipped;
+        if (!m_target.pixels || !clipRect(rect, clipped))
+            return;
+
+        patch.draw(reinterpret_cast<QC::u32 *>(m_target.pixels), m_target.pitch / sizeof(QC::u32), rect, clipped);
+    }
+
     void FramebufferBackend::fillRectAlpha(const QC::Rect &rect, QC::Color color)
     {
         if (color.a == 0 || !m_target.pixels)
@@ -18,4 +18,12 @@ namespace QW
             m_framebuffer->swap();
         }
     }
+
+    void FramebufferPresentBackend::present(const QC::Rect *dirtyRects, QC::usize dirtyCount)
+    {
+        if (m_framebuffer)
+        {
+            m_framebuffer->swap(dirtyRects, dirtyCount);
+        }
+    }
 }
@@ -0,0 +1,235 @@
+// QWindowing Performance HUD - on-screen frame statistics overlay
+// Namespace: QW
+
+#include "QWPerfHud.h"
+#include "QWFrameScheduler.h"
+#include "QKMemHeap.h"
+#include "QKMemPMM.h"
+#include "QKEventManager.h"
+#include "QCBuiltins.h"
+
+namespace QW
+{
+
+    namespace
+    {
+        constexpr QC::i32 kMargin = 8;  // Distance from the screen corner
+        constexpr QC::i32 kPad = 4;     // Inner padding
+        constexpr QC::i32 kLineH = 10;  // 5x7 glyph rows plus spacing
+        constexpr QC::i32 kGraphH = 36; // Frame-time graph height
+        constexpr QC::i32 kBarW = 2;
+
+        const Color kBackground = Color::fromRGB(16, 16, 24);
+        const Color kText = Color::fromRGB(220, 220, 220);
+        const Color kGood = Color::fromRGB(64, 200, 96);
+        const Color kLate = Color::fromRGB(230, 64, 48);
+        const Color kGuide = Color::fromRGB(96, 96, 120);
+
+        /// Fixed-size line builder (no printf in the kernel)
+        struct TextLine
+        {
+            char text[32];
+            QC::usize length = 0;
+
+            TextLine() { text[0] = '\0'; }
+
+            TextLine &str(const char *s)
+            {
+                while (*s && length + 1 < sizeof(text))
+                {
+                    text[length++] = *s++;
+                }
+                text[length] = '\0';
+                return *this;
+            }
+
+            TextLine &num(QC::u64 value)
+            {
+                char digits[20];
+                QC::usize n = 0;
+                do
+                {
+                    digits[n++] = static_cast<char>('0' + value % 10);
+                    value /= 10;
+                } while (value != 0);
+
+                while (n > 0 && length + 1 < sizeof(text))
+                {
+                    text[length++] = digits[--n];
+                }
+                text[length] = '\0';
+                return *this;
+            }
+
+            /// Value given in tenths, printed as "x.y"
+            TextLine &tenths(QC::u64 value)
+            {
+                num(value / 10);
+                str(".");
+                return num(value % 10);
+            }
+        };
+
+        /// Cycles to tenths of a millisecond (0 without a calibrated TSC)
+        QC::u64 cyclesToTenthMs(QC::u64 cycles, QC::u64 tscFrequency)
+        {
+            return tscFrequency ? (cycles * 10000u) / tscFrequency : 0;
+        }
+    }
+
+    PerfHud::PerfHud()
+        : m_pixels(nullptr),
+          m_surface(),
+          m_rect(),
+          m_visible(false),
+          m_fpsWindowStart(0),
+          m_fpsWindowFrames(0),
+          m_fps(0)
+    {
+        m_pixels = static_cast<QC::u32 *>(
+            QK::Memory::Heap::instance().allocate(Width * Height * sizeof(QC::u32)));
+        if (m_pixels)
+        {
+            m_surface.setSurface(m_pixels, Width, Height);
+        }
+    }
+
+    PerfHud::~PerfHud()
+    {
+        if (m_pixels)
+        {
+            QK::Memory::Heap::instance().free(m_pixels);
+            m_pixels = nullptr;
+        }
+    }
+
+    void PerfHud::setScreenSize(QC::u32 width, QC::u32 height)
+    {
+        (void)height;
+        const QC::i32 x = static_cast<QC::i32>(width) - static_cast<QC::i32>(Width) - kMargin;
+        m_rect = Rect{x > 0 ? x : 0, kMargin, Width, Height};
+    }
+
+    void PerfHud::update(QC::u64 damagedPixels, bool fullPresent, QC::u32 frameCount)
+    {
+        if (!m_pixels)
+            return;
+
+        auto &scheduler = FrameScheduler::instance();
+        const QC::u64 tscFrequency = scheduler.tscFrequency();
+
+        // FPS over windows of about a second of compositor frames.
+        const QC::u64 now = QC::rdtsc();
+        if (m_fpsWindowStart == 0)
+        {
+            m_fpsWindowStart = now;
+            m_fpsWindowFrames = frameCount;
+        }
+        else if (tscFrequency && now - m_fpsWindowStart >= tscFrequency)
+        {
+            m_fps = static_cast<QC::u32>(
+                (static_cast<QC::u64>(frameCount - m_fpsWindowFrames) * tscFrequency) / (now - m_fpsWindowStart));
+            m_fpsWindowStart = now;
+            m_fpsWindowFrames = frameCount;
+        }
+
+        QG::IPainter &painter = m_surface;
+        painter.fillRect(Rect{0, 0, Width, Height}, kBackground);
+
+        QC::i32 y = kPad;
+        {
+            TextLine line;
+            line.str("FPS ").num(m_fps).str("  FRAME ")
+                .tenths(cyclesToTenthMs(scheduler.lastValue(FrameMetric::Total), tscFrequency))
+                .str(" MS");
+            painter.drawText(kPad, y, line.text, kText);
+        }
+        y += kLineH;
+
+        drawGraph(Rect{kPad, y, Width - 2 * kPad, kGraphH});
+        y += kGraphH + 4;
+
+        {
+            TextLine line;
+            line.str("DMG ").num(damagedPixels).str(fullPresent ? " PX FULL" : " PX PART");
+            painter.drawText(kPad, y, line.text, kText);
+        }
+        y += kLineH;
+        {
+            TextLine line;
+            line.str("HEAP ").num(QK::Memory::Heap::instance().usedSize() / 1024).str(" KB");
+            painter.drawText(kPad, y, line.text, kText);
+        }
+        y += kLineH;
+        {
+            TextLine line;
+            line.str("PMM FREE ").num(QK::Memory::PMM::instance().freePages()).str(" PG");
+            painter.drawText(kPad, y, line.text, kText);
+        }
+        y += kLineH;
+        {
+            TextLine line;
+            line.str("EVQ ").num(QK::Event::EventManager::instance().pendingEventCount());
+            line.str("  MISS ").num(scheduler.missedFrames());
+            painter.drawText(kPad, y, line.text, kText);
+        }
+        y += kLineH;
+        {
+            TextLine line;
+            line.str("P99 ")
+                .tenths(cyclesToTenthMs(scheduler.percentile(FrameMetric::Total, 99), tscFrequency))
+                .str(" IN ")
+                .tenths(cyclesToTenthMs(scheduler.percentile(FrameMetric::InputLatency, 99), tscFrequency))
+                .str(" MS");
+            painter.drawText(kPad, y, line.text, kText);
+        }
+    }
+
+    void PerfHud::drawGraph(const Rect &area)
+    {
+        auto &scheduler = FrameScheduler::instance();
+        QG::IPainter &painter = m_surface;
+
+        // Full height is two frame intervals; without pacing, the largest sample.
+        QC::u64 scale = scheduler.frameInterval() * 2;
+        const QC::usize bars = area.width / kBarW;
+        if (scale == 0)
+        {
+            for (QC::usize age = 0; age < bars; ++age)
+            {
+                const QC::u64 v = scheduler.recentValue(FrameMetric::Total, age);
+                if (v > scale)
+                    scale = v;
+            }
+        }
+        if (scale == 0)
+            return;
+
+        const QC::i32 bottom = area.bottom();
+        if (scheduler.frameInterval() != 0)
+        {
+            painter.drawHLine(area.x, bottom - static_cast<QC::i32>(area.height / 2), area.width, kGuide);
+        }
+
+        // Newest frame on the right.
+        for (QC::usize age = 0; age < bars; ++age)
+        {
+            const QC::u64 v = scheduler.recentValue(FrameMetric::Total, age);
+            if (v == 0)
+                continue;
+
+            QC::u64 h = (v * area.height) / scale;
+            if (h > area.height)
+                h = area.height;
+            if (h == 0)
+                h = 1;
+
+            const bool late = scheduler.frameInterval() != 0 && v > scheduler.frameInterval();
+            const QC::i32 x = area.right() - static_cast<QC::i32>((age + 1) * kBarW);
+            painter.fillRect(Rect{x, bottom - static_cast<QC::i32>(h), static_cast<QC::u32>(kBarW),
+                                  static_cast<QC::u32>(h)},
+                             late ? kLate : kGood);
+        }
+    }
+
+} // namespace QW
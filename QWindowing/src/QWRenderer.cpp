@@ -33,7 +33,8 @@ namespace QW
 
     void Renderer::setClipRect(const Rect &rect)
     {
-        m_clipRect = rect;
+        // Keep the clip inside the target so callers may pass unclipped damage.
+        m_clipRect = rect.intersection(Rect{0, 0, m_width, m_height});
         m_hasClipRect = true;
     }
 
@@ -76,6 +77,29 @@ namespace QW
         return c;
     }
 
+    void Renderer::readPixels(const Rect &rect, QC::u32 *dst, QC::u32 dstPitch) const
+    {
+        if (!dst || !m_buffer)
+            return;
+
+        const Rect src = rect.intersection(Rect{0, 0, m_width, m_height});
+        if (src.isEmpty())
+            return;
+
+        const QC::i32 startX = src.x - rect.x;
+        const QC::i32 startY = src.y - rect.y;
+        const QG::PixelKernels &kernels = QG::PixelKernels::instance();
+
+        for (QC::u32 row = 0; row < src.height; ++row)
+        {
+            const QC::u32 *srcRow = reinterpret_cast<const QC::u32 *>(
+                reinterpret_cast<const QC::u8 *>(m_buffer) + (src.y + static_cast<QC::i32>(row)) * m_pitch) + src.x;
+            QC::u32 *dstRow = reinterpret_cast<QC::u32 *>(
+                reinterpret_cast<QC::u8 *>(dst) + (startY + static_cast<QC::i32>(row)) * dstPitch) + startX;
+            kernels.copy(dstRow, srcRow, src.width);
+        }
+    }
+
     void Renderer::drawLine(QC::i32 x1, QC::i32 y1, QC::i32 x2, QC::i32 y2, Color color)
     {
         // Bresenham's line algorithm
@@ -108,18 +132,12 @@ namespace QW
 
     void Renderer::drawHLine(QC::i32 x, QC::i32 y, QC::u32 length, Color color)
     {
-        for (QC::u32 i = 0; i < length; ++i)
-        {
-            setPixel(x + static_cast<QC::i32>(i), y, color);
-        }
+        fillRect(Rect{x, y, length, 1}, color);
     }
 
     void Renderer::drawVLine(QC::i32 x, QC::i32 y, QC::u32 length, Color color)
     {
-        for (QC::u32 i = 0; i < length; ++i)
-        {
-            setPixel(x, y + static_cast<QC::i32>(i), color);
-        }
+        fillRect(Rect{x, y, 1, length}, color);
     }
 
     void Renderer::drawRect(const Rect &rect, Color color)
@@ -136,14 +154,11 @@ namespace QW
         if (!clipRect(clipped))
             return;
 
-        for (QC::i32 y = clipped.y; y < clipped.y + static_cast<QC::i32>(clipped.height); ++y)
+        const QG::PixelKernels &kernels = QG::PixelKernels::instance();
+        QC::u8 *row = reinterpret_cast<QC::u8 *>(m_buffer) + clipped.y * m_pitch;
+        for (QC::u32 i = 0; i < clipped.height; ++i, row += m_pitch)
         {
-            QC::u32 *row = reinterpret_cast<QC::u32 *>(
-                reinterpret_cast<QC::u8 *>(m_buffer) + y * m_pitch);
-            for (QC::i32 x = clipped.x; x < clipped.x + static_cast<QC::i32>(clipped.width); ++x)
-            {
-                row[x] = color.value;
-            }
+            kernels.fill(reinterpret_cast<QC::u32 *>(row) + clipped.x, color.value, clipped.width);
         }
     }
 
@@ -253,32 +268,7 @@ namespace QW
     void Renderer::blit(QC::i32 x, QC::i32 y, const QC::u32 *src,
                         QC::u32 srcWidth, QC::u32 srcHeight, QC::u32 srcPitch)
     {
-        if (!src || !m_buffer)
-            return;
-
-        // Clip to screen
-        QC::i32 startX = x < 0 ? -x : 0;
-        QC::i32 startY = y < 0 ? -y : 0;
-        QC::i32 endX = static_cast<QC::i32>(srcWidth);
-        QC::i32 endY = static_cast<QC::i32>(srcHeight);
-
-        if (x + endX > static_cast<QC::i32>(m_width))
-            endX = static_cast<QC::i32>(m_width) - x;
-        if (y + endY > static_cast<QC::i32>(m_height))
-            endY = static_cast<QC::i32>(m_height) - y;
-
-        for (QC::i32 sy = startY; sy < endY; ++sy)
-        {
-            const QC::u32 *srcRow = reinterpret_cast<const QC::u32 *>(
-                reinterpret_cast<const QC::u8 *>(src) + sy * srcPitch);
-            QC::u32 *dstRow = reinterpret_cast<QC::u32 *>(
-                reinterpret_cast<QC::u8 *>(m_buffer) + (y + sy) * m_pitch);
-
-            for (QC::i32 sx = startX; sx < endX; ++sx)
-            {
-                dstRow[x + sx] = srcRow[sx];
-            }
-        }
+        blitRows(x, y, src, srcWidth, srcHeight, srcPitch, QG::SurfaceFormat::Opaque);
     }
 
     void Renderer::blitScaled(const Rect &dest, const QC::u32 *src,
@@ -294,55 +284,50 @@ namespace QW
 
     void Renderer::blitAlpha(QC::i32 x, QC::i32 y, const QC::u32 *src,
                              QC::u32 srcWidth, QC::u32 srcHeight, QC::u32 srcPitch)
+    {
+        blitRows(x, y, src, srcWidth, srcHeight, srcPitch, QG::SurfaceFormat::Straight);
+    }
+
+    void Renderer::blitPremultiplied(QC::i32 x, QC::i32 y, const QC::u32 *src,
+                                     QC::u32 srcWidth, QC::u32 srcHeight, QC::u32 srcPitch)
+    {
+        blitRows(x, y, src, srcWidth, srcHeight, srcPitch, QG::SurfaceFormat::Premultiplied);
+    }
+
+    void Renderer::blitRows(QC::i32 x, QC::i32 y, const QC::u32 *src,
+                            QC::u32 srcWidth, QC::u32 srcHeight, QC::u32 srcPitch,
+                            QG::SurfaceFormat format)
     {
         if (!src || !m_buffer)
             return;
 
-        // Clip to screen
-        QC::i32 startX = x < 0 ? -x : 0;
-        QC::i32 startY = y < 0 ? -y : 0;
-        QC::i32 endX = static_cast<QC::i32>(srcWidth);
-        QC::i32 endY = static_cast<QC::i32>(srcHeight);
+        // Clip to the active clip rect (screen when none is set)
+        Rect dest{x, y, srcWidth, srcHeight};
+        if (!clipRect(dest))
+            return;
 
-        if (x + endX > static_cast<QC::i32>(m_width))
-            endX = static_cast<QC::i32>(m_width) - x;
-        if (y + endY > static_cast<QC::i32>(m_height))
-            endY = static_cast<QC::i32>(m_height) - y;
+        const QC::i32 startX = dest.x - x;
+        const QC::i32 startY = dest.y - y;
+        const QG::PixelKernels &kernels = QG::PixelKernels::instance();
 
-        for (QC::i32 sy = startY; sy < endY; ++sy)
+        for (QC::u32 row = 0; row < dest.height; ++row)
         {
             const QC::u32 *srcRow = reinterpret_cast<const QC::u32 *>(
-                reinterpret_cast<const QC::u8 *>(src) + sy * srcPitch);
+                reinterpret_cast<const QC::u8 *>(src) + (startY + static_cast<QC::i32>(row)) * srcPitch) + startX;
             QC::u32 *dstRow = reinterpret_cast<QC::u32 *>(
-                reinterpret_cast<QC::u8 *>(m_buffer) + (y + sy) * m_pitch);
+                reinterpret_cast<QC::u8 *>(m_buffer) + (dest.y + static_cast<QC::i32>(row)) * m_pitch) + dest.x;
 
-            for (QC::i32 sx = startX; sx < endX; ++sx)
+            switch (format)
             {
-                QC::u32 srcPixel = srcRow[sx];
-                QC::u8 alpha = (srcPixel >> 24) & 0xFF;
-
-                if (alpha == 255)
-                {
-                    dstRow[x + sx] = srcPixel;
-                }
-                else if (alpha > 0)
-                {
-                    QC::u32 dstPixel = dstRow[x + sx];
-
-                    QC::u8 sr = (srcPixel >> 16) & 0xFF;
-                    QC::u8 sg = (srcPixel >> 8) & 0xFF;
-                    QC::u8 sb = srcPixel & 0xFF;
-
-                    QC::u8 dr = (dstPixel >> 16) & 0xFF;
-                    QC::u8 dg = (dstPixel >> 8) & 0xFF;
-                    QC::u8 db = dstPixel & 0xFF;
-
-                    QC::u8 outR = static_cast<QC::u8>((sr * alpha + dr * (255 - alpha)) / 255);
-                    QC::u8 outG = static_cast<QC::u8>((sg * alpha + dg * (255 - alpha)) / 255);
-                    QC::u8 outB = static_cast<QC::u8>((sb * alpha + db * (255 - alpha)) / 255);
-
-                    dstRow[x + sx] = (0xFF << 24) | (outR << 16) | (outG << 8) | outB;
-                }
+            case QG::SurfaceFormat::Opaque:
+                kernels.copy(dstRow, srcRow, dest.width);
+                break;
+            case QG::SurfaceFormat::Premultiplied:
+                kernels.blendPremultiplied(dstRow, srcRow, dest.width);
+                break;
+            case QG::SurfaceFormat::Straight:
+                kernels.blend(dstRow, srcRow, dest.width);
+                break;
             }
         }
     }
@@ -448,10 +448,8 @@ namespace QW
         const bool hasShadow = !disabled && spec.castsShadow && caps.supportsShadows && spec.glow.a > 0 && styleData.metrics.buttonShadowSoftness > 0;
         if (hasShadow)
         {
-            QC::Rect shadowRect = buttonRect;
-            shadowRect.x += styleData.metrics.buttonShadowOffsetX;
-            shadowRect.y += styleData.metrics.buttonShadowOffsetY;
-            m_backend->drawShadow(shadowRect,
+            // drawShadow applies the offset itself.
+            m_backend->drawShadow(buttonRect,
                                   {styleData.metrics.buttonShadowOffsetX, styleData.metrics.buttonShadowOffsetY},
                                   static_cast<QC::i32>(styleData.metrics.buttonShadowSoftness),
                                   spec.glow,
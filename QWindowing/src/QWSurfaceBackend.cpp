@@ -1,6 +1,8 @@
 // QWindowing SurfaceBackend implementation
 
 #include "QWSurfaceBackend.h"
+#include "QG/NinePatch.h"
+#include "QGPixelKernels.h"
 
 #include <algorithm>
 
@@ -10,7 +12,7 @@ namespace QW
     SurfaceBackend::SurfaceBackend()
         : m_surface(nullptr)
     {
-        m_caps.supportsRoundedRect = false;
+        m_caps.supportsRoundedRect = true;
         m_caps.supportsShadows = true;
         m_caps.supportsAlpha = true;
         m_target = TargetDesc{};
@@ -99,8 +101,17 @@ namespace QW
                                          QC::Color stroke,
                                          QC::u32 strokeWidth)
     {
-        (void)radius;
-        drawRect(rect, fill, stroke, strokeWidth);
+        if (!ensureSurface() || rect.isEmpty())
+            return;
+
+        const QG::NinePatch *patch = QG::NinePatchCache::instance().roundedRectFor(rect, radius, strokeWidth, fill, stroke);
+        if (!patch)
+        {
+            drawRect(rect, fill, stroke, strokeWidth);
+            return;
+        }
+
+        drawNinePatch(*patch, rect);
     }
 
     void SurfaceBackend::drawShadow(const QC::Rect &rect,
@@ -109,14 +120,21 @@ namespace QW
                                     QC::Color color,
                                     QC::u8 opacity)
     {
-        (void)blurRadius; // Blur not supported yet on surface backend
-        if (!ensureSurface() || opacity == 0)
+        if (!ensureSurface() || opacity == 0 || rect.isEmpty())
             return;
 
-        QC::Rect shadowRect = rect;
-        shadowRect.x += offset.x;
-        shadowRect.y += offset.y;
-        fillRectAlpha(shadowRect, color.withAlpha(opacity));
+        const QC::Rect shadowRect = rect.offset(offset.x, offset.y);
+        const QC::Color tint = color.withAlpha(opacity);
+
+        QC::Rect patchRect;
+        const QG::NinePatch *patch = QG::NinePatchCache::instance().shadowFor(shadowRect, blurRadius, tint, patchRect);
+        if (!patch)
+        {
+            fillRectAlpha(shadowRect, tint);
+            return;
+        }
+
+        drawNinePatch(*patch, patchRect);
     }
 
     void SurfaceBackend::blit(const QC::Rect &rect,
@@ -137,15 +155,28 @@ namespace QW
         }
     }
 
+    bool SurfaceBackend::scrollRect(const QC::Rect &rect, QC::i32 dx, QC::i32 dy)
+    {
+        if (!ensureSurface())
+            return false;
+
+        return m_surface->scrollRect(rect, dx, dy);
+    }
+
     bool SurfaceBackend::clipRect(const QC::Rect &rect, QC::Rect &clipped) const
     {
         if (!ensureSurface())
             return false;
 
-        QC::i32 x1 = std::max(rect.x, 0);
-        QC::i32 y1 = std::max(rect.y, 0);
-        QC::i32 x2 = std::min(rect.x + static_cast<QC::i32>(rect.width), static_cast<QC::i32>(m_target.width));
-        QC::i32 y2 = std::min(rect.y + static_cast<QC::i32>(rect.height), static_cast<QC::i32>(m_target.height));
+        // Respect the painter clip as well as the target bounds.
+        const QC::Rect clip = m_surface->clipRect();
+
+        QC::i32 x1 = std::max(std::max(rect.x, 0), clip.x);
+        QC::i32 y1 = std::max(std::max(rect.y, 0), clip.y);
+        QC::i32 x2 = std::min(std::min(rect.x + static_cast<QC::i32>(rect.width), static_cast<QC::i32>(m_target.width)),
+                              clip.right());
+        QC::i32 y2 = std::min(std::min(rect.y + static_cast<QC::i32>(rect.height), static_cast<QC::i32>(m_target.height)),
+                              clip.bottom());
 
         if (x2 <= x1 || y2 <= y1)
             return false;
@@ -157,6 +188,15 @@ namespace QW
         return true;
     }
 
+    void SurfaceBackend::drawNinePatch(const QG::NinePatch &patch, const QC::Rect &rect)
+    {
+        QC::Rect clipped;
+        if (!m_target.pixels || !clipRect(rect, clipped))
+            return;
+
+        patch.draw(reinterpret_cast<QC::u32 *>(m_target.pixels), m_target.pitch / sizeof(QC::u32), rect, clipped);
+    }
+
     void SurfaceBackend::fillRectAlpha(const QC::Rect &rect, QC::Color color)
     {
         if (!ensureSurface() || color.a == 0)
@@ -166,15 +206,11 @@ namespace QW
         if (!clipRect(rect, clipped))
             return;
 
+        const QG::PixelKernels &kernels = QG::PixelKernels::instance();
         for (QC::i32 row = 0; row < static_cast<QC::i32>(clipped.height); ++row)
         {
             QC::u32 *dstRow = reinterpret_cast<QC::u32 *>(m_target.pixels + (clipped.y + row) * m_target.pitch);
-            for (QC::i32 col = 0; col < static_cast<QC::i32>(clipped.width); ++col)
-            {
-                QC::u32 &dstPixel = dstRow[clipped.x + col];
-                QC::Color dstColor(dstPixel);
-                dstPixel = color.blend(dstColor).value;
-            }
+            kernels.blendSolid(dstRow + clipped.x, color.value, clipped.width);
         }
     }
 
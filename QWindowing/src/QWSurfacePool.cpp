@@ -0,0 +1,205 @@
+// QWindowing SurfacePool - reusable window pixel buffers
+// Namespace: QW
+
+#include "QWSurfacePool.h"
+#include "QKMemHeap.h"
+#include "QKMemPMM.h"
+#include "QCLogger.h"
+
+namespace QW
+{
+
+    namespace
+    {
+        constexpr QC::usize kSmallBucketLimit = 64 * 1024;
+
+        inline QC::usize alignUp(QC::usize value, QC::usize alignment)
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        inline QC::usize highestPowerOfTwo(QC::usize value)
+        {
+            QC::usize p = 1;
+            while (p <= value / 2)
+                p <<= 1;
+            return p;
+        }
+    } // namespace
+
+    bool PooledSurface::relayout(QC::u32 newWidth, QC::u32 newHeight)
+    {
+        if (!pixels)
+            return false;
+
+        const QC::u32 pitch = SurfacePool::pitchFor(newWidth);
+        const QC::usize needed = static_cast<QC::usize>(pitch) * newHeight;
+        if (needed > capacityBytes || capacityBytes > SurfacePool::bucketSize(needed) * 2)
+            return false;
+
+        width = newWidth;
+        height = newHeight;
+        pitchBytes = pitch;
+        return true;
+    }
+
+    SurfacePool &SurfacePool::instance()
+    {
+        static SurfacePool pool;
+        return pool;
+    }
+
+    QC::u32 SurfacePool::pitchFor(QC::u32 width)
+    {
+        return static_cast<QC::u32>(alignUp(static_cast<QC::usize>(width) * sizeof(QC::u32), RowAlignBytes));
+    }
+
+    QC::usize SurfacePool::bucketSize(QC::usize bytes)
+    {
+        bytes = alignUp(bytes, BufferAlignBytes);
+        if (bytes <= kSmallBucketLimit)
+        {
+            QC::usize p = highestPowerOfTwo(bytes);
+            return p == bytes ? p : p * 2;
+        }
+
+        // Eighth steps keep the rounding waste under 12.5% for large surfaces.
+        const QC::usize step = highestPowerOfTwo(bytes) / 8;
+        return alignUp(bytes, step);
+    }
+
+    bool SurfacePool::underPressure()
+    {
+        return QK::Memory::PMM::instance().freePages() < LowMemoryPages;
+    }
+
+    PooledSurface SurfacePool::allocate(QC::usize capacity)
+    {
+        auto &heap = QK::Memory::Heap::instance();
+
+        // The heap does not align, so over-allocate and align the pixels inside the block.
+        void *block = heap.allocate(capacity + BufferAlignBytes);
+        if (!block && m_cachedCount > 0)
+        {
+            trim(0);
+            block = heap.allocate(capacity + BufferAlignBytes);
+        }
+        if (!block)
+            return PooledSurface{};
+
+        PooledSurface surface;
+        surface.block = block;
+        surface.capacityBytes = capacity;
+        surface.pixels = reinterpret_cast<QC::u32 *>(
+            alignUp(reinterpret_cast<QC::usize>(block), BufferAlignBytes));
+        return surface;
+    }
+
+    void SurfacePool::freeSurface(PooledSurface &surface)
+    {
+        if (surface.block)
+            QK::Memory::Heap::instance().free(surface.block);
+        surface = PooledSurface{};
+    }
+
+    PooledSurface SurfacePool::acquire(QC::u32 width, QC::u32 height)
+    {
+        if (width == 0 || height == 0)
+            return PooledSurface{};
+
+        const QC::usize needed = static_cast<QC::usize>(pitchFor(width)) * height;
+        const QC::usize bucket = bucketSize(needed);
+
+        // Smallest cached buffer that fits, but never one more than twice the
+        // bucket: a small dialog should not pin a full-screen buffer.
+        QC::usize best = MaxCached;
+        for (QC::usize i = 0; i < m_cachedCount; ++i)
+        {
+            const QC::usize capacity = m_cached[i].capacityBytes;
+            if (capacity < needed || capacity > bucket * 2)
+                continue;
+            if (best == MaxCached || capacity < m_cached[best].capacityBytes)
+                best = i;
+        }
+
+        PooledSurface surface;
+        if (best != MaxCached)
+        {
+            surface = m_cached[best];
+            m_cached[best] = m_cached[--m_cachedCount];
+            m_cached[m_cachedCount] = PooledSurface{};
+            m_cachedBytes -= surface.capacityBytes;
+            ++m_hits;
+        }
+        else
+        {
+            surface = allocate(bucket);
+            ++m_misses;
+            if (!surface.isValid())
+            {
+                QC_LOG_WARN("QWSurfacePool", "Surface allocation failed");
+                return surface;
+            }
+        }
+
+        surface.relayout(width, height);
+        return surface;
+    }
+
+    void SurfacePool::release(PooledSurface &surface)
+    {
+        if (!surface.isValid())
+        {
+            surface = PooledSurface{};
+            return;
+        }
+
+        if (underPressure() || surface.capacityBytes > m_budgetBytes)
+        {
+            trim(0);
+            freeSurface(surface);
+            return;
+        }
+
+        // Make room: evict the largest cached buffers first, they are the least
+        // likely to be asked for again and free the most.
+        while (m_cachedCount > 0 &&
+               (m_cachedCount == MaxCached || m_cachedBytes + surface.capacityBytes > m_budgetBytes))
+        {
+            QC::usize largest = 0;
+            for (QC::usize i = 1; i < m_cachedCount; ++i)
+            {
+                if (m_cached[i].capacityBytes > m_cached[largest].capacityBytes)
+                    largest = i;
+            }
+            m_cachedBytes -= m_cached[largest].capacityBytes;
+            freeSurface(m_cached[largest]);
+            m_cached[largest] = m_cached[--m_cachedCount];
+            m_cached[m_cachedCount] = PooledSurface{};
+        }
+
+        m_cached[m_cachedCount++] = surface;
+        m_cachedBytes += surface.capacityBytes;
+        surface = PooledSurface{};
+    }
+
+    QC::usize SurfacePool::trim(QC::usize keepBytes)
+    {
+        QC::usize freed = 0;
+        while (m_cachedCount > 0 && m_cachedBytes > keepBytes)
+        {
+            PooledSurface &last = m_cached[--m_cachedCount];
+            m_cachedBytes -= last.capacityBytes;
+            freed += last.capacityBytes;
+            freeSurface(last);
+        }
+        return freed;
+    }
+
+    void SurfacePool::setBudget(QC::usize bytes)
+    {
+        m_budgetBytes = bytes;
+        trim(bytes);
+    }
+
+} // namespace QW
@@ -0,0 +1,217 @@
+// QWindowing TileGrid - Screen tiles with a damage bitmap
+// Namespace: QW
+
+#include "QWTileGrid.h"
+
+namespace QW
+{
+
+    void TileGrid::resize(QC::u32 width, QC::u32 height)
+    {
+        m_width = width;
+        m_height = height;
+        m_columns = (width + TileSize - 1) >> TileShift;
+        m_rows = (height + TileSize - 1) >> TileShift;
+        m_bits.resize((static_cast<QC::usize>(tileCount()) + 63) / 64);
+        clear();
+    }
+
+    void TileGrid::clear()
+    {
+        for (QC::usize i = 0; i < m_bits.size(); ++i)
+            m_bits[i] = 0;
+        m_dirtyCount = 0;
+    }
+
+    void TileGrid::markAll()
+    {
+        const QC::u32 count = tileCount();
+        for (QC::usize i = 0; i < m_bits.size(); ++i)
+            m_bits[i] = ~0ull;
+        if (count & 63)
+            m_bits[m_bits.size() - 1] = (1ull << (count & 63)) - 1;
+        m_dirtyCount = count;
+    }
+
+    bool TileGrid::tileSpan(const QC::Rect &rect, QC::u32 &col0, QC::u32 &col1, QC::u32 &row0, QC::u32 &row1) const
+    {
+        const QC::Rect clipped = rect.intersection(QC::Rect{0, 0, m_width, m_height});
+        if (clipped.isEmpty())
+            return false;
+
+        col0 = static_cast<QC::u32>(clipped.x) >> TileShift;
+        row0 = static_cast<QC::u32>(clipped.y) >> TileShift;
+        col1 = (static_cast<QC::u32>(clipped.right()) + TileSize - 1) >> TileShift;
+        row1 = (static_cast<QC::u32>(clipped.bottom()) + TileSize - 1) >> TileShift;
+        return true;
+    }
+
+    void TileGrid::mark(const QC::Rect &rect)
+    {
+        QC::u32 col0, col1, row0, row1;
+        if (!tileSpan(rect, col0, col1, row0, row1))
+            return;
+
+        for (QC::u32 row = row0; row < row1; ++row)
+        {
+            for (QC::u32 tile = row * m_columns + col0, end = row * m_columns + col1; tile < end; ++tile)
+            {
+                QC::u64 &word = m_bits[tile >> 6];
+                const QC::u64 bit = 1ull << (tile & 63);
+                if (!(word & bit))
+                {
+                    word |= bit;
+                    ++m_dirtyCount;
+                }
+            }
+        }
+    }
+
+    bool TileGrid::isDirty(const QC::Rect &rect) const
+    {
+        QC::u32 col0, col1, row0, row1;
+        if (m_dirtyCount == 0 || !tileSpan(rect, col0, col1, row0, row1))
+            return false;
+
+        for (QC::u32 row = row0; row < row1; ++row)
+        {
+            for (QC::u32 col = col0; col < col1; ++col)
+            {
+                if (isDirty(row * m_columns + col))
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    QC::u32 TileGrid::nextDirty(QC::u32 tile) const
+    {
+        const QC::u32 count = tileCount();
+        if (tile >= count)
+            return count;
+
+        QC::usize wordIndex = tile >> 6;
+        QC::u64 word = m_bits[wordIndex] & (~0ull << (tile & 63));
+        for (;;)
+        {
+            if (word)
+            {
+                const QC::u32 found = static_cast<QC::u32>(wordIndex * 64) + static_cast<QC::u32>(__builtin_ctzll(word));
+                return found < count ? found : count;
+            }
+            if (++wordIndex >= m_bits.size())
+                return count;
+            word = m_bits[wordIndex];
+        }
+    }
+
+    QC::Rect TileGrid::spanRect(QC::u32 col0, QC::u32 col1, QC::u32 row0, QC::u32 row1) const
+    {
+        const QC::u32 x = col0 << TileShift;
+        const QC::u32 y = row0 << TileShift;
+        const QC::u32 right = (col1 << TileShift) < m_width ? (col1 << TileShift) : m_width;
+        const QC::u32 bottom = (row1 << TileShift) < m_height ? (row1 << TileShift) : m_height;
+        return QC::Rect{static_cast<QC::i32>(x), static_cast<QC::i32>(y), right - x, bottom - y};
+    }
+
+    QC::Rect TileGrid::tileRect(QC::u32 tile) const
+    {
+        const QC::u32 col = tile % m_columns;
+        const QC::u32 row = tile / m_columns;
+        return spanRect(col, col + 1, row, row + 1);
+    }
+
+    void TileGrid::collectRects(QC::Vector<QC::Rect> &out, QC::usize maxRects)
+    {
+        out.clear();
+        if (m_dirtyCount == 0 || maxRects == 0)
+            return;
+
+        if (isFull())
+        {
+            out.push_back(QC::Rect{0, 0, m_width, m_height});
+            return;
+        }
+
+        // Runs of the previous row, then of this row, both in column order.
+        // The vectors are members so their storage is reused frame to frame.
+        m_runs[0].clear();
+        m_runs[1].clear();
+        QC::u32 previous = 0;
+        for (QC::u32 row = 0; row < m_rows; ++row)
+        {
+            QC::Vector<TileRun> &above = m_runs[previous];
+            QC::Vector<TileRun> &current = m_runs[previous ^ 1];
+            current.clear();
+
+            QC::usize match = 0;
+            const QC::u32 base = row * m_columns;
+            QC::u32 col = 0;
+            while (col < m_columns)
+            {
+                if (!isDirty(base + col))
+                {
+                    ++col;
+                    continue;
+                }
+
+                const QC::u32 col0 = col;
+                while (col < m_columns && isDirty(base + col))
+                    ++col;
+
+                while (match < above.size() && above[match].col1 <= col0)
+                    ++match;
+
+                TileRun run{col0, col, 0};
+                if (match < above.size() && above[match].col0 == col0 && above[match].col1 == col)
+                {
+                    // Same columns as the run above: grow that rect downwards.
+                    run.rect = above[match].rect;
+                    const QC::Rect grown = spanRect(col0, col, 0, row + 1);
+                    out[run.rect].height = static_cast<QC::u32>(grown.bottom() - out[run.rect].y);
+                }
+                else
+                {
+                    run.rect = out.size();
+                    out.push_back(spanRect(col0, col, row, row + 1));
+                    if (out.size() > maxRects)
+                    {
+                        collectBands(out, maxRects);
+                        return;
+                    }
+                }
+                current.push_back(run);
+            }
+
+            previous ^= 1;
+        }
+    }
+
+    void TileGrid::collectBands(QC::Vector<QC::Rect> &out, QC::usize maxRects) const
+    {
+        out.clear();
+        const QC::u32 bandRows = static_cast<QC::u32>((m_rows + maxRects - 1) / maxRects);
+        for (QC::u32 row0 = 0; row0 < m_rows; row0 += bandRows)
+        {
+            const QC::u32 row1 = row0 + bandRows < m_rows ? row0 + bandRows : m_rows;
+            QC::u32 col0 = m_columns;
+            QC::u32 col1 = 0;
+            for (QC::u32 row = row0; row < row1; ++row)
+            {
+                for (QC::u32 col = 0; col < m_columns; ++col)
+                {
+                    if (!isDirty(row * m_columns + col))
+                        continue;
+                    if (col < col0)
+                        col0 = col;
+                    if (col + 1 > col1)
+                        col1 = col + 1;
+                }
+            }
+
+            if (col0 < col1)
+                out.push_back(spanRect(col0, col1, row0, row1));
+        }
+    }
+
+} // namespace QW
@@ -10,6 +10,54 @@
 
 namespace QW
 {
+    namespace
+    {
+        QC::u64 rectArea(const QC::Rect &rect)
+        {
+            return static_cast<QC::u64>(rect.width) * rect.height;
+        }
+
+        // Overlapping or sharing an edge (touching corners count too; the
+        // waste check rejects those).
+        bool touches(const QC::Rect &a, const QC::Rect &b)
+        {
+            return !(b.x > a.right() || b.right() < a.x ||
+                     b.y > a.bottom() || b.bottom() < a.y);
+        }
+
+        // Merge overlapping/adjacent rects while the union adds little area the
+        // inputs do not cover; exact neighbours (same span) always merge.
+        QC::usize coalesceRects(QC::Rect *rects, QC::usize count)
+        {
+            bool merged = true;
+            while (merged)
+            {
+                merged = false;
+                for (QC::usize i = 0; i < count && !merged; ++i)
+                {
+                    for (QC::usize j = i + 1; j < count; ++j)
+                    {
+                        const QC::Rect &a = rects[i];
+                        const QC::Rect &b = rects[j];
+                        if (!touches(a, b))
+                            continue;
+
+                        const QC::Rect u = a.united(b);
+                        const QC::u64 covered = rectArea(a) + rectArea(b) - rectArea(a.intersection(b));
+                        if ((rectArea(u) - covered) * 8 > covered)
+                            continue;
+
+                        rects[i] = u;
+                        rects[j] = rects[--count];
+                        merged = true;
+                        break;
+                    }
+                }
+            }
+            return count;
+        }
+    }
+
     void VmwareSVGAPresentBackend::initialize(Framebuffer *fb)
     {
         m_framebuffer = fb;
@@ -22,78 +70,121 @@ namespace QW
         present(nullptr, 0);
     }
 
+    void VmwareSVGAPresentBackend::retireCompleted()
+    {
+        auto &svga = QDrv::VmwareSVGA::instance();
+        while (m_inFlightCount > 0 && svga.hasFencePassed(m_inFlight[m_inFlightHead].fence))
+        {
+            m_inFlightHead = (m_inFlightHead + 1) % MaxInFlight;
+            --m_inFlightCount;
+        }
+    }
+
+    void VmwareSVGAPresentBackend::waitForOverlap(const QC::Rect *rects, QC::usize count)
+    {
+        // Fences pass in order, so waiting on the newest overlapping present
+        // covers every older one as well.
+        QC::u32 fence = 0;
+        for (QC::usize i = 0; i < m_inFlightCount; ++i)
+        {
+            const InFlight &entry = m_inFlight[(m_inFlightHead + i) % MaxInFlight];
+            for (QC::usize r = 0; r < count; ++r)
+            {
+                if (entry.bounds.intersects(rects[r]))
+                {
+                    fence = entry.fence;
+                    break;
+                }
+            }
+        }
+
+        if (fence != 0)
+        {
+            QDrv::VmwareSVGA::instance().syncToFence(fence);
+            retireCompleted();
+        }
+    }
+
     void VmwareSVGAPresentBackend::present(const QC::Rect *dirtyRects, QC::usize dirtyCount)
     {
         static QC::u32 s_presentCount = 0;
         ++s_presentCount;
         if ((s_presentCount % 240u) == 1u)
         {
-            QC_LOG_INFO("QWPresent", "VmwareSVGAPresentBackend::present #%u (dirty=%lu)",
+            QC_LOG_INFO("QWPresent", "VmwareSVGAPresentBackend::present #%u (dirty=%lu in-flight=%lu)",
                         s_presentCount,
-                        static_cast<unsigned long>(dirtyCount));
+                        static_cast<unsigned long>(dirtyCount),
+                        static_cast<unsigned long>(m_inFlightCount));
         }
 
         if (!m_framebuffer)
             return;
 
-        // We still swap the whole backbuffer today (rendering path is still full-frame).
-        m_framebuffer->swap();
-
         auto &svga = QDrv::VmwareSVGA::instance();
         if (!(svga.has2D() || svga.initialize2D()))
+        {
+            m_framebuffer->swap(dirtyRects, dirtyCount);
             return;
+        }
 
         const QC::u32 fbW = m_framebuffer->width();
         const QC::u32 fbH = m_framebuffer->height();
+        const QC::Rect screen{0, 0, fbW, fbH};
 
-        // If no dirty rects are provided, we don't know what's changed;
-        // update the whole frame so QEMU refreshes its surface.
-        if (!dirtyRects || dirtyCount == 0)
+        // Clip to the screen and coalesce. Unknown or excessive damage means
+        // the whole frame; QEMU then refreshes its entire surface.
+        QC::Rect rects[MaxUpdateRects];
+        QC::usize count = 0;
+        if (dirtyRects && dirtyCount > 0 && dirtyCount <= MaxUpdateRects)
         {
-            svga.updateRect(0, 0, fbW, fbH);
-            return;
+            for (QC::usize i = 0; i < dirtyCount; ++i)
+            {
+                const QC::Rect r = dirtyRects[i].intersection(screen);
+                if (!r.isEmpty())
+                {
+                    rects[count++] = r;
+                }
+            }
+            count = coalesceRects(rects, count);
+            if (count == 0)
+                return;
         }
+        else
+        {
+            rects[count++] = screen;
+        }
+
+        retireCompleted();
 
-        // Clamp/clip each rect to screen and issue UPDATE.
-        // If we get an excessive number of rects, fall back to fullscreen.
-        if (dirtyCount > 128)
+        // The host may still be reading VRAM for an earlier present; only the
+        // presents that overlap this frame's rects have to finish first.
+        waitForOverlap(rects, count);
+        if (m_inFlightCount == MaxInFlight)
         {
-            svga.updateRect(0, 0, fbW, fbH);
-            return;
+            svga.syncToFence(m_inFlight[m_inFlightHead].fence);
+            retireCompleted();
         }
 
-        for (QC::usize i = 0; i < dirtyCount; ++i)
+        m_framebuffer->swap(rects, count);
+
+        if (!svga.updateRects(rects, count))
+            return;
+
+        QC::Rect bounds = rects[0];
+        for (QC::usize i = 1; i < count; ++i)
         {
-            const QC::Rect &r = dirtyRects[i];
-            if (r.isEmpty())
-                continue;
-
-            QC::i32 x0 = r.x;
-            QC::i32 y0 = r.y;
-            QC::i32 x1 = r.right();
-            QC::i32 y1 = r.bottom();
-
-            if (x1 <= 0 || y1 <= 0)
-                continue;
-            if (x0 >= static_cast<QC::i32>(fbW) || y0 >= static_cast<QC::i32>(fbH))
-                continue;
-
-            if (x0 < 0)
-                x0 = 0;
-            if (y0 < 0)
-                y0 = 0;
-            if (x1 > static_cast<QC::i32>(fbW))
-                x1 = static_cast<QC::i32>(fbW);
-            if (y1 > static_cast<QC::i32>(fbH))
-                y1 = static_cast<QC::i32>(fbH);
-
-            const QC::u32 w = static_cast<QC::u32>(x1 - x0);
-            const QC::u32 h = static_cast<QC::u32>(y1 - y0);
-            if (w == 0 || h == 0)
-                continue;
-
-            svga.updateRect(static_cast<QC::u32>(x0), static_cast<QC::u32>(y0), w, h);
+            bounds = bounds.united(rects[i]);
         }
+
+        const QC::u32 fence = svga.insertFence();
+        if (fence == 0)
+            return;
+
+        // Slot at head + count; the full-queue wait above guarantees room.
+        InFlight &slot = m_inFlight[(m_inFlightHead + m_inFlightCount) % MaxInFlight];
+        slot.fence = fence;
+        slot.bounds = bounds;
+        ++m_inFlightCount;
     }
 
     bool VmwareSVGAPresentBackend::hasHardwareCursor() const
@@ -1,6 +1,7 @@
 #include "QWWindow.h"
 #include "QWMessageBus.h"
 #include "QWWindowManager.h"
+#include "QGPixelKernels.h"
 #include "QWControls/Containers/Panel.h"
 #include "QKEventTypes.h"
 #include <cstring>
@@ -16,10 +17,13 @@ namespace QW
           m_surfaceBackend(),
           m_styleRenderer(),
           m_painter(),
-          m_surfacePixels(),
+          m_surface(),
           m_bufferWidth(0),
           m_bufferHeight(0),
-          m_bufferPitchBytes(0)
+          m_bufferPitchBytes(0),
+          m_bufferFormat(QG::SurfaceFormat::Opaque),
+          m_dirtyRect(),
+          m_paintPending(false)
     {
         std::strncpy(m_title, title ? title : "", sizeof(m_title) - 1);
         m_title[sizeof(m_title) - 1] = '\0';
@@ -39,6 +43,8 @@ namespace QW
     {
         delete m_root;
         m_root = nullptr;
+
+        SurfacePool::instance().release(m_surface);
     }
 
     uint32_t Window::windowId() const { return m_windowId; }
@@ -95,7 +101,7 @@ namespace QW
 
     const QC::u32 *Window::buffer() const
     {
-        return m_surfacePixels.empty() ? nullptr : m_surfacePixels.data();
+        return m_surface.pixels;
     }
 
     QC::u32 Window::bufferWidth() const
@@ -113,6 +119,23 @@ namespace QW
         return m_bufferPitchBytes;
     }
 
+    bool Window::isOpaque() const
+    {
+        return m_bufferFormat == QG::SurfaceFormat::Opaque &&
+               m_surface.isValid() &&
+               m_bufferWidth >= m_bounds.width &&
+               m_bufferHeight >= m_bounds.height;
+    }
+
+    void Window::setBufferFormat(QG::SurfaceFormat format)
+    {
+        if (m_bufferFormat == format)
+            return;
+
+        m_bufferFormat = format;
+        invalidate();
+    }
+
     void Window::invalidate()
     {
         invalidateRect(Rect{0, 0, m_bounds.width, m_bounds.height});
@@ -145,12 +168,64 @@ namespace QW
                                   clipped.width,
                                   clipped.height};
             WindowManager::instance().invalidate(screenRect);
+
+            // Painting happens once per frame, however many invalidations arrive.
+            m_dirtyRect = m_dirtyRect.united(clipped);
+            m_paintPending = true;
         }
+    }
+
+    void Window::scrollRect(const Rect &rect, QC::i32 dx, QC::i32 dy)
+    {
+        const Rect area = rect.intersection(Rect{0, 0, m_bounds.width, m_bounds.height});
+        if (area.isEmpty() || (dx == 0 && dy == 0))
+            return;
 
-        paint();
+        const QC::i32 absDx = dx < 0 ? -dx : dx;
+        const QC::i32 absDy = dy < 0 ? -dy : dy;
+        const bool hasSurface = m_bufferWidth == m_bounds.width && m_bufferHeight == m_bounds.height;
+        if (!hasSurface || absDx >= static_cast<QC::i32>(area.width) ||
+            absDy >= static_cast<QC::i32>(area.height) || !m_painter.scrollRect(area, dx, dy))
+        {
+            invalidateRect(area);
+            return;
+        }
+
+        // Pending damage travels with the pixels it covers.
+        if (m_paintPending)
+        {
+            const Rect moved = m_dirtyRect.intersection(area).offset(dx, dy).intersection(area);
+            if (!moved.isEmpty())
+                m_dirtyRect = m_dirtyRect.united(moved);
+        }
+
+        // The moved pixels only need recomposing; the uncovered strips need painting.
+        WindowManager::instance().invalidate(area.offset(m_bounds.x, m_bounds.y));
+
+        if (dy > 0)
+            invalidateRect(Rect{area.x, area.y, area.width, static_cast<QC::u32>(dy)});
+        else if (dy < 0)
+            invalidateRect(Rect{area.x, area.bottom() + dy, area.width, static_cast<QC::u32>(-dy)});
+
+        if (dx > 0)
+            invalidateRect(Rect{area.x, area.y, static_cast<QC::u32>(dx), area.height});
+        else if (dx < 0)
+            invalidateRect(Rect{area.right() + dx, area.y, static_cast<QC::u32>(-dx), area.height});
+    }
+
+    void Window::paintPending()
+    {
+        if (!m_paintPending || !isVisible())
+            return;
+
+        const Rect dirty = m_dirtyRect;
+        m_dirtyRect = Rect();
+        m_paintPending = false;
+
+        paint(dirty);
     }
 
-    void Window::paint()
+    void Window::paint(const Rect &clip)
     {
         if (!isVisible())
             return;
@@ -158,6 +233,10 @@ namespace QW
         if (!ensureSurface(m_bounds.width, m_bounds.height))
             return;
 
+        // Everything below draws through the painter; controls outside the
+        // clip are skipped by their containers.
+        m_painter.setClipRect(clip);
+
         float textScale = 1.0f;
         if (const StyleSnapshot *snapshot = m_styleRenderer.styleSnapshot())
         {
@@ -178,7 +257,10 @@ namespace QW
         frameCtx.painter = &m_painter;
 
         if (!m_styleRenderer.beginFrame(frameCtx))
+        {
+            m_painter.clearClipRect();
             return;
+        }
 
         WindowPaintArgs chromeArgs{};
         // Treat borderless/titleless windows as a desktop surface so the style system
@@ -203,6 +285,7 @@ namespace QW
             m_root->paint(controlCtx);
 
         m_styleRenderer.endFrame();
+        m_painter.clearClipRect();
 
         onPaint();
     }
@@ -247,7 +330,7 @@ namespace QW
     {
         if (width == 0 || height == 0)
         {
-            m_surfacePixels.resize(0);
+            SurfacePool::instance().release(m_surface);
             m_bufferWidth = 0;
             m_bufferHeight = 0;
             m_bufferPitchBytes = 0;
@@ -256,21 +339,34 @@ namespace QW
             return false;
         }
 
-        const bool sizeChanged = (width != m_bufferWidth) || (height != m_bufferHeight) || m_surfacePixels.empty();
+        const bool sizeChanged = (width != m_bufferWidth) || (height != m_bufferHeight) || !m_surface.isValid();
         if (sizeChanged)
         {
-            const QC::usize pixelCount = static_cast<QC::usize>(width) * static_cast<QC::usize>(height);
-            m_surfacePixels.resize(pixelCount);
-            m_bufferWidth = width;
-            m_bufferHeight = height;
-            m_bufferPitchBytes = width * sizeof(QC::u32);
+            // Resizes within the bucket keep the buffer; anything else goes
+            // back to the pool and comes out of it again.
+            if (!m_surface.relayout(width, height))
+            {
+                SurfacePool &pool = SurfacePool::instance();
+                pool.release(m_surface);
+                m_surface = pool.acquire(width, height);
+                if (m_surface.isValid())
+                {
+                    // Recycled pixels belong to another window until the first paint.
+                    const QC::u32 pitchPixels = m_surface.pitchBytes / sizeof(QC::u32);
+                    QG::PixelKernels::instance().fillRect(m_surface.pixels, pitchPixels,
+                                                          Rect{0, 0, width, height}, 0);
+                }
+            }
+            m_bufferWidth = m_surface.width;
+            m_bufferHeight = m_surface.height;
+            m_bufferPitchBytes = m_surface.pitchBytes;
         }
 
-        if (m_surfacePixels.empty())
+        if (!m_surface.isValid())
             return false;
 
-        QC::u32 *pixelData = m_surfacePixels.data();
-        m_painter.setSurface(pixelData, m_bufferWidth, m_bufferHeight, m_bufferWidth);
+        QC::u32 *pixelData = m_surface.pixels;
+        m_painter.setSurface(pixelData, m_bufferWidth, m_bufferHeight, m_bufferPitchBytes / sizeof(QC::u32));
         m_surfaceBackend.setSurface(&m_painter,
                                     pixelData,
                                     m_bufferWidth,
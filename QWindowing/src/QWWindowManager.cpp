@@ -5,12 +5,14 @@
 #include "QWWindow.h"
 #include "QWFramebuffer.h"
 #include "QWCompositor.h"
+#include "QWFrameScheduler.h"
 #include "QWStyleSystem.h"
 #include "QWMessageBus.h"
 #include "QKEventManager.h"
 #include "QKMemHeap.h"
 #include "QCMemUtil.h"
 #include "QCLinearAlgebra.h"
+#include "QCBuiltins.h"
 
 namespace QW
 {
@@ -106,6 +108,8 @@ namespace QW
             return false;
         }
 
+        FrameScheduler::instance().noteInput(event.timestamp());
+
         switch (event.type())
         {
         case Type::MouseMove:
@@ -336,6 +340,17 @@ namespace QW
     {
         if (m_compositor)
         {
+            // Flush deferred window painting so each dirty window paints once.
+            const QC::u64 paintStart = QC::rdtsc();
+            for (QC::usize i = 0; i < m_windows.size(); ++i)
+            {
+                if (m_windows[i]->needsPaint())
+                {
+                    m_windows[i]->paintPending();
+                }
+            }
+            FrameScheduler::instance().addTime(FrameMetric::Paint, QC::rdtsc() - paintStart);
+
             m_compositor->compose();
             m_needsRender = false;
         }
@@ -1,6 +1,7 @@
 #include "Boot/Desktop/DesktopSession.h"
 
 #include "QCLogger.h"
+#include "QCBuiltins.h"
 
 #include "QKMemHeap.h"
 #include "QArchPCI.h"
@@ -12,6 +13,8 @@
 #include "QWFramebuffer.h"
 #include "QWWindowManager.h"
 #include "QWWindow.h"
+#include "QWFrameScheduler.h"
+#include "QWCompositor.h"
 
 #include "QKEventManager.h"
 #include "QKEventListener.h"
@@ -52,6 +55,12 @@ namespace
     static QK::Event::EventListener g_CtrlQListener;
     static QK::Event::ListenerId g_CtrlQId = QK::Event::InvalidListenerId;
 
+    // Frame pacing for the desktop loop: at most one frame per slot, and event
+    // dispatch may use at most half of a frame so composition/present always
+    // get their share.
+    static constexpr QC::u32 kFrameRateHz = 60;
+    static constexpr QC::u64 kEventBudgetDivisor = 2;
+
     static bool g_prevLeftBtn = false;
     static bool g_prevRightBtn = false;
 
@@ -267,6 +276,11 @@ namespace QK::Boot::Desktop
         QK::Shutdown::Controller::instance();
         g_Log("Shutdown controller ready\r\n");
 
+        // Calibrate the TSC first: calibration borrows PIT channel 0, which the
+        // tick timer below reprograms.
+        QDrv::HighResTimer::instance().initialize();
+        QK::Event::EventManager::instance().setTimestampFrequency(QDrv::HighResTimer::instance().tscFrequency());
+
         // Initialize timer (higher tick reduces input polling latency).
         g_Log("Initializing timer...\r\n");
         QDrv::Timer::instance().initialize(1000);
@@ -632,7 +646,7 @@ namespace QK::Boot::Desktop
             QW::WindowManager::instance().render();
             g_Log("Initial render complete!\r\n");
 
-            // Register keyboard listener for Ctrl+Q shutdown.
+            // Register keyboard listener for Ctrl+Q shutdown and the F12 HUD toggle.
             g_CtrlQListener.categoryMask = QK::Event::Category::Input;
             g_CtrlQListener.eventType = QK::Event::Type::KeyDown;
             g_CtrlQListener.handler = [](const QK::Event::Event &event, void *) -> bool
@@ -649,6 +663,16 @@ namespace QK::Boot::Desktop
                         static_cast<QC::u32>(QK::Shutdown::Reason::KeyboardShortcut));
                     return true;
                 }
+
+                // F12 toggles the performance HUD.
+                if (key.keycode == static_cast<QC::u8>(QKDrv::PS2::Key::F12))
+                {
+                    if (QW::Compositor *compositor = QW::WindowManager::instance().compositor())
+                    {
+                        compositor->toggleHud();
+                    }
+                    return true;
+                }
                 return false;
             };
             g_CtrlQListener.userData = nullptr;
@@ -668,25 +692,53 @@ namespace QK::Boot::Desktop
         // Main loop - process events and render.
         g_Log("Entering main loop...\r\n");
 
+        auto &eventMgr = QK::Event::EventManager::instance();
+        auto &scheduler = QW::FrameScheduler::instance();
+        scheduler.initialize(eventMgr.timestampFrequency(), kFrameRateHz);
+        const QC::u64 eventBudgetTicks = scheduler.frameInterval() / kEventBudgetDivisor;
+
         while (true)
         {
+            const QC::u64 frameStart = QC::rdtsc();
+
             // Poll all active drivers.
             QKDrv::Manager::instance().poll();
 
             // Also explicitly poll keyboard (debug).
             QKDrv::PS2::Keyboard::instance().poll();
 
-            // Process pending events.
-            QK::Event::EventManager::instance().processEvents();
+            // Process pending events, bounded so a burst cannot starve rendering.
+            // Without a calibrated TSC fall back to draining everything.
+            if (eventBudgetTicks != 0)
+            {
+                eventMgr.processEventsUntilDeadline(frameStart + eventBudgetTicks);
+            }
+            else
+            {
+                eventMgr.processEvents();
+            }
+            const QC::u64 eventsDone = QC::rdtsc();
+            scheduler.addTime(QW::FrameMetric::Events, eventsDone - frameStart);
 
-            // Render only when something invalidated.
+            // Render only when something invalidated, at most once per frame
+            // slot; invalidations before the slot opens render together.
             auto &wm = QW::WindowManager::instance();
-            if (wm.needsRender())
+            if (wm.needsRender() && scheduler.frameDue(eventsDone))
             {
+                scheduler.beginFrame(eventsDone);
                 wm.render();
+                scheduler.endFrame(QC::rdtsc());
+            }
+
+            // Leftover events carry over: loop again right away instead of
+            // waiting for the next interrupt.
+            if (eventMgr.hasPendingEvents())
+            {
+                continue;
             }
 
-            // Halt until next interrupt.
+            // Halt until next interrupt (the 1 kHz timer bounds the wait for
+            // the next frame slot).
             asm volatile("hlt");
         }
     }